@@ -84,6 +84,10 @@ async function runDemo() {
     // Demonstrate promise integration
     console.log("\nSimple brew demonstration:");
     await brewCoffee(espresso);
+    // WebAssembly compiled from a file on disk
+    console.log("\nWebAssembly demonstration:");
+    const adder = await WebAssembly.instantiate(await loadWasm("../scripts/add.wasm"));
+    console.log(`add(2, 3) = ${adder.exports.add(2, 3)}`);
     console.log("\nDemo completed! TypeScript + V8 provides seamless C++ integration.");
 }
 // Execute the demo
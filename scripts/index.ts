@@ -101,6 +101,11 @@ async function runDemo(): Promise<void> {
     console.log("\nSimple brew demonstration:");
     await brewCoffee(espresso);
 
+    // WebAssembly compiled from a file on disk
+    console.log("\nWebAssembly demonstration:");
+    const adder = await WebAssembly.instantiate(await loadWasm("../scripts/add.wasm"));
+    console.log(`add(2, 3) = ${adder.exports.add(2, 3)}`);
+
     console.log("\nDemo completed! TypeScript + V8 provides seamless C++ integration.");
 }
 
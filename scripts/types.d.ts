@@ -7,6 +7,31 @@
  */
 declare function wait(milliseconds: number): Promise<void>;
 
+/**
+ * Loads and compiles a WebAssembly module from a local file.
+ * Compilation streams from disk; compiled modules are cached on disk and
+ * shared across runtimes in the process, so later loads skip compilation.
+ * @param path The .wasm file to load
+ * @returns A promise that resolves with the compiled module
+ */
+declare function loadWasm(path: string): Promise<WebAssembly.Module>;
+
+/**
+ * Minimal WebAssembly declarations (not part of the ES2020 lib).
+ */
+declare namespace WebAssembly {
+    class Module {
+        constructor(bytes: ArrayBuffer | ArrayBufferView);
+    }
+
+    class Instance {
+        constructor(module: Module, imports?: Record<string, Record<string, unknown>>);
+        readonly exports: Record<string, any>;
+    }
+
+    function instantiate(module: Module, imports?: Record<string, Record<string, unknown>>): Promise<Instance>;
+}
+
 /**
  * Represents a coffee machine that can brew recipes.
  */
@@ -79,6 +104,64 @@ declare class Recipe {
     getDescription(): string;
 }
 
+/**
+ * A native, indexed collection of recipes loaded in bulk from disk.
+ * Identical recipes share a single Recipe instance.
+ */
+declare class RecipeCatalog {
+    /**
+     * Creates a catalog, optionally loading a file right away.
+     * @param path A .json file (array of recipe objects) or a CSV file
+     */
+    constructor(path?: string);
+
+    /**
+     * Loads recipes from a .json file (array of {name, strength, waterAmount, brewTime})
+     * or a CSV file with those columns.
+     * @param path The file to load
+     * @returns The number of records read, including duplicates
+     */
+    load(path: string): number;
+
+    /**
+     * Looks up a recipe by name.
+     * @param name The recipe name
+     * @returns The first recipe loaded under that name, or null
+     */
+    byName(name: string): Recipe | null;
+
+    /**
+     * Finds recipes within inclusive strength and brew time ranges.
+     * @param minStrength Minimum strength (0-100)
+     * @param maxStrength Maximum strength (0-100)
+     * @param minBrewTime Minimum brewing time in milliseconds
+     * @param maxBrewTime Maximum brewing time in milliseconds
+     * @returns Matching recipes ordered by strength, then brew time
+     */
+    query(minStrength: number, maxStrength: number, minBrewTime?: number, maxBrewTime?: number): Recipe[];
+
+    /**
+     * Gets the number of distinct recipes.
+     * @returns The catalog size
+     */
+    size(): number;
+}
+
+/**
+ * Events posted by the host application.
+ */
+declare const host: {
+    /**
+     * Subscribes to events of one type. The handler runs once per batch
+     * with every payload posted since the last delivery, oldest first:
+     * numbers, strings, ArrayBuffers (handed over without copying) or
+     * deserialized structured values.
+     * @param type The event type
+     * @param handler Receives the batch of payloads
+     */
+    on(type: string, handler: (payloads: unknown[]) => void): void;
+};
+
 /**
  * Console object for logging.
  */
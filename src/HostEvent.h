@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <v8.h>
+
+// Bytes that reach scripts as an ArrayBuffer without being copied.
+//
+// The memory comes from the runtime's ArrayBuffer allocator, which places
+// it where V8 accepts ArrayBuffer contents (inside the sandbox when that is
+// enabled), so delivery only wraps it in a backing store. Obtain one from
+// V8Runtime::createEventBuffer and fill it on any thread. Each buffer shares
+// ownership of the allocator, so it may safely outlive the runtime.
+class EventBuffer {
+ public:
+  EventBuffer() = default;
+
+  EventBuffer(
+      std::shared_ptr<v8::ArrayBuffer::Allocator> allocator, std::size_t size
+  )
+      : allocator_(std::move(allocator)), size_(size) {
+    if (size_ > 0) {
+      data_ = allocator_->AllocateUninitialized(size_);
+      if (!data_) {
+        throw std::bad_alloc();
+      }
+    }
+  }
+
+  ~EventBuffer() {
+    if (data_) {
+      allocator_->Free(data_, size_);
+    }
+  }
+
+  EventBuffer(EventBuffer &&other) noexcept
+      : allocator_(std::move(other.allocator_)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  EventBuffer &operator=(EventBuffer &&other) noexcept {
+    std::swap(allocator_, other.allocator_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  uint8_t *data() noexcept { return static_cast<uint8_t *>(data_); }
+
+  std::size_t size() const noexcept { return size_; }
+
+  // Hands the memory to a new ArrayBuffer; this buffer is empty afterwards
+  v8::Local<v8::ArrayBuffer> toArrayBuffer(v8::Isolate *isolate) {
+    if (!data_) {
+      return v8::ArrayBuffer::New(isolate, 0);
+    }
+
+    // The deleter keeps its own reference to the allocator
+    std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(
+        std::exchange(data_, nullptr),
+        std::exchange(size_, 0),
+        [](void *data, std::size_t length, void *owner) {
+          const std::unique_ptr<AllocatorRef> allocator(
+              static_cast<AllocatorRef *>(owner)
+          );
+          (*allocator)->Free(data, length);
+        },
+        new AllocatorRef(allocator_)
+    );
+    return v8::ArrayBuffer::New(isolate, std::move(store));
+  }
+
+ private:
+  using AllocatorRef = std::shared_ptr<v8::ArrayBuffer::Allocator>;
+
+  AllocatorRef allocator_;
+  void *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Output of a v8::ValueSerializer, e.g. from another runtime. Rebuilt with
+// a ValueDeserializer on delivery, for structured payloads that have no
+// direct representation.
+struct SerializedValue {
+  std::vector<uint8_t> bytes;
+};
+
+// A message from host code to the handlers a script registered with
+// host.on(type, fn). Numbers and empty payloads convert for free, strings
+// are copied once, EventBuffers are handed over without copying.
+struct HostEvent {
+  using Payload = std::variant<
+      std::monostate, double, std::string, EventBuffer, SerializedValue>;
+
+  std::string type;
+  Payload payload;
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <v8.h>
+
+#include "utils/MappedFile.h"
+
+// JavaScript source backed by a read-only file mapping.
+//
+// The script text is handed to V8 as an external string, so it is never
+// copied onto the V8 heap. Pure ASCII files (the common case for compiled
+// bundles) are exposed directly as a one-byte string over the mapping. Any
+// other file is transcoded to UTF-16 once, on first use, and that buffer is
+// shared by every isolate that compiles the same ScriptSource.
+//
+// V8 keeps reading the source long after the first compile, because inner
+// functions are compiled lazily from it. A mapped ASCII file must therefore
+// not be truncated or rewritten in place while scripts from it are alive:
+// V8 would see the new text or the process would take SIGBUS. Replace files
+// by writing a new one and renaming it over the old. Small ASCII files are
+// copied onto the heap instead, where saving the copy does not matter.
+class ScriptSource {
+ public:
+  static std::shared_ptr<const ScriptSource> load(const std::string &path) {
+    return std::shared_ptr<const ScriptSource>(
+        new ScriptSource(MappedFile::open(path))
+    );
+  }
+
+  const std::string &path() const noexcept { return file_->path(); }
+
+  bool isOneByte() const noexcept { return oneByte_; }
+
+  // Only ASCII can be passed through as Latin-1; any byte >= 0x80 is part of
+  // a multi-byte UTF-8 sequence. Checks eight bytes per step.
+  static bool isAscii(std::string_view text) noexcept {
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= text.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, text.data() + i, sizeof(word));
+      if (word & kHighBits) {
+        return false;
+      }
+    }
+    for (; i < text.size(); ++i) {
+      if (static_cast<unsigned char>(text[i]) & 0x80) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Files below this size are copied rather than referenced
+  static constexpr std::size_t kCopyThreshold = 64 * 1024;
+
+  // Creates a V8 string for this source, referencing it without a copy
+  // unless it is small. Must be called with `isolate` entered.
+  v8::Local<v8::String> toV8String(v8::Isolate *isolate) const {
+    if (file_->size() == 0) {
+      return v8::String::Empty(isolate);
+    }
+
+    if (oneByte_) {
+      if (file_->size() > static_cast<std::size_t>(v8::String::kMaxLength)) {
+        throw std::runtime_error("Script too large: " + path());
+      }
+      if (file_->size() < kCopyThreshold) {
+        return v8::String::NewFromOneByte(
+                   isolate,
+                   reinterpret_cast<const uint8_t *>(file_->data()),
+                   v8::NewStringType::kNormal,
+                   static_cast<int>(file_->size())
+        )
+            .ToLocalChecked();
+      }
+      return v8::String::NewExternalOneByte(isolate, new OneByteResource(file_))
+          .ToLocalChecked();
+    }
+
+    const auto text = utf16();
+    if (text->size() > static_cast<std::size_t>(v8::String::kMaxLength)) {
+      throw std::runtime_error("Script too large: " + path());
+    }
+    return v8::String::NewExternalTwoByte(isolate, new TwoByteResource(text))
+        .ToLocalChecked();
+  }
+
+ private:
+  // Keeps the mapping alive for as long as V8 references the string
+  class OneByteResource : public v8::String::ExternalOneByteStringResource {
+   public:
+    explicit OneByteResource(std::shared_ptr<const MappedFile> file)
+        : file_(std::move(file)) {}
+
+    const char *data() const override { return file_->data(); }
+
+    size_t length() const override { return file_->size(); }
+
+   private:
+    std::shared_ptr<const MappedFile> file_;
+  };
+
+  class TwoByteResource : public v8::String::ExternalStringResource {
+   public:
+    explicit TwoByteResource(std::shared_ptr<const std::u16string> text)
+        : text_(std::move(text)) {}
+
+    const uint16_t *data() const override {
+      return reinterpret_cast<const uint16_t *>(text_->data());
+    }
+
+    size_t length() const override { return text_->size(); }
+
+   private:
+    std::shared_ptr<const std::u16string> text_;
+  };
+
+  explicit ScriptSource(std::shared_ptr<const MappedFile> file)
+      : file_(std::move(file)), oneByte_(isAscii(file_->view())) {}
+
+  std::shared_ptr<const std::u16string> utf16() const {
+    std::call_once(utf16Once_, [this] {
+      utf16_ =
+          std::make_shared<const std::u16string>(decodeUtf8(file_->view()));
+    });
+    return utf16_;
+  }
+
+  // Malformed sequences decode to U+FFFD, matching NewFromUtf8
+  static std::u16string decodeUtf8(std::string_view text) {
+    constexpr char16_t kReplacement = 0xFFFD;
+
+    std::u16string out;
+    out.reserve(text.size());
+
+    const auto *bytes = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    std::size_t i = 0;
+
+    // Skip a UTF-8 byte order mark
+    if (size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+      i = 3;
+    }
+
+    while (i < size) {
+      const unsigned char lead = bytes[i];
+      if (lead < 0x80) {
+        out.push_back(lead);
+        ++i;
+        continue;
+      }
+
+      int extra;
+      char32_t codePoint;
+      char32_t minimum;
+      if ((lead & 0xE0) == 0xC0) {
+        extra = 1, codePoint = lead & 0x1F, minimum = 0x80;
+      } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2, codePoint = lead & 0x0F, minimum = 0x800;
+      } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3, codePoint = lead & 0x07, minimum = 0x10000;
+      } else {
+        out.push_back(kReplacement);
+        ++i;
+        continue;
+      }
+
+      std::size_t consumed = 1;
+      bool valid = true;
+      for (int k = 0; k < extra; ++k, ++consumed) {
+        if (i + consumed >= size || (bytes[i + consumed] & 0xC0) != 0x80) {
+          valid = false;
+          break;
+        }
+        codePoint = (codePoint << 6) | (bytes[i + consumed] & 0x3F);
+      }
+      i += consumed;
+
+      if (!valid || codePoint < minimum || codePoint > 0x10FFFF ||
+          (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        out.push_back(kReplacement);
+      } else if (codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        out.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+        out.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+      } else {
+        out.push_back(static_cast<char16_t>(codePoint));
+      }
+    }
+
+    return out;
+  }
+
+  std::shared_ptr<const MappedFile> file_;
+  bool oneByte_;
+
+  mutable std::once_flag utf16Once_;
+  mutable std::shared_ptr<const std::u16string> utf16_;
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <v8.h>
+
+#include "ScriptSource.h"
+
+// JavaScript read in chunks from a file or stdin and compiled while it is
+// still arriving.
+//
+// start() hands the source to a ScriptStreamingTask on a V8 worker thread,
+// which pulls chunks as it needs them, so reading, parsing and bytecode
+// generation overlap off the isolate thread. compile() waits for that task
+// and runs only the final main-thread step of ScriptCompiler::Compile.
+class StreamedScript {
+ public:
+  // "-" reads standard input
+  explicit StreamedScript(std::string path)
+      : path_(std::move(path)),
+        source_(
+            std::make_unique<ChunkStream>(*this, openDescriptor(path_)),
+            v8::ScriptCompiler::StreamedSource::UTF8
+        ),
+        done_(finished_.get_future()) {}
+
+  // The worker references this object until its task returns
+  ~StreamedScript() {
+    if (task_) {
+      done_.wait();
+    }
+  }
+
+  StreamedScript(const StreamedScript &) = delete;
+  StreamedScript &operator=(const StreamedScript &) = delete;
+
+  const std::string &path() const noexcept { return path_; }
+
+  // Begins background compilation. Must be called once, with `isolate`
+  // entered.
+  void start(v8::Isolate *isolate, v8::Platform *platform) {
+    task_.reset(v8::ScriptCompiler::StartStreaming(isolate, &source_));
+
+    // The isolate thread blocks on the result, so ask for high priority
+    platform->CallBlockingTaskOnWorkerThread(
+        std::make_unique<CompileTask>(task_.get(), finished_)
+    );
+  }
+
+  // Waits for the worker, then finishes compilation in `context`. Empty if
+  // the script failed to compile.
+  v8::MaybeLocal<v8::Script> compile(const v8::Local<v8::Context> context) {
+    done_.wait();
+    if (readFailed_) {
+      throw std::runtime_error("Failed to read script: " + path_);
+    }
+
+    auto *isolate = context->GetIsolate();
+    const v8::ScriptOrigin origin(
+        v8::String::NewFromUtf8(isolate, path_.c_str()).ToLocalChecked()
+    );
+    return v8::ScriptCompiler::Compile(
+        context,
+        &source_,
+        fullSource(isolate),
+        origin
+    );
+  }
+
+ private:
+  // Pulled by V8 on the worker thread. Every chunk is also kept, because
+  // the final compile step needs the complete source string.
+  class ChunkStream : public v8::ScriptCompiler::ExternalSourceStream {
+   public:
+    ChunkStream(StreamedScript &script, int fd) : script_(script), fd_(fd) {}
+
+    ~ChunkStream() override {
+      if (fd_ != STDIN_FILENO) {
+        ::close(fd_);
+      }
+    }
+
+    size_t GetMoreData(const uint8_t **src) override {
+      constexpr std::size_t kChunkSize = 64 * 1024;
+
+      // V8 mishandles a UTF-8 sequence split across more than two chunks,
+      // so no chunk before the last is shorter than the longest sequence
+      constexpr std::size_t kMinimumChunk = 4;
+
+      auto chunk = std::make_unique<uint8_t[]>(kChunkSize);
+      std::size_t filled = 0;
+      while (filled < kMinimumChunk) {
+        const ssize_t count =
+            ::read(fd_, chunk.get() + filled, kChunkSize - filled);
+        if (count < 0 && errno == EINTR) {
+          continue;
+        }
+        if (count < 0) {
+          script_.readFailed_ = true;
+        }
+        if (count <= 0) {
+          break;
+        }
+        filled += static_cast<std::size_t>(count);
+      }
+
+      if (filled == 0) {
+        *src = nullptr;
+        return 0;
+      }
+
+      const std::string_view bytes(
+          reinterpret_cast<const char *>(chunk.get()),
+          filled
+      );
+      script_.text_.append(bytes);
+      script_.oneByte_ = script_.oneByte_ && ScriptSource::isAscii(bytes);
+
+      *src = chunk.release();  // V8 takes ownership
+      return filled;
+    }
+
+   private:
+    StreamedScript &script_;
+    int fd_;
+  };
+
+  class CompileTask : public v8::Task {
+   public:
+    CompileTask(
+        v8::ScriptCompiler::ScriptStreamingTask *task,
+        std::promise<void> &finished
+    )
+        : task_(task), finished_(finished) {}
+
+    void Run() override {
+      task_->Run();
+      finished_.set_value();
+    }
+
+   private:
+    v8::ScriptCompiler::ScriptStreamingTask *task_;
+    std::promise<void> &finished_;
+  };
+
+  // Takes over the text read by the worker, so ASCII sources reach the
+  // V8 heap without another copy
+  class OneByteResource : public v8::String::ExternalOneByteStringResource {
+   public:
+    explicit OneByteResource(std::string text) : text_(std::move(text)) {}
+
+    const char *data() const override { return text_.data(); }
+
+    size_t length() const override { return text_.size(); }
+
+   private:
+    std::string text_;
+  };
+
+  static int openDescriptor(const std::string &path) {
+    if (path == "-") {
+      return STDIN_FILENO;
+    }
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open file: " + path);
+    }
+    return fd;
+  }
+
+  v8::Local<v8::String> fullSource(v8::Isolate *isolate) {
+    if (text_.empty()) {
+      return v8::String::Empty(isolate);
+    }
+    if (text_.size() > static_cast<std::size_t>(v8::String::kMaxLength)) {
+      throw std::runtime_error("Script too large: " + path_);
+    }
+
+    if (oneByte_) {
+      return v8::String::NewExternalOneByte(
+                 isolate,
+                 new OneByteResource(std::move(text_))
+      )
+          .ToLocalChecked();
+    }
+    return v8::String::NewFromUtf8(
+               isolate,
+               text_.data(),
+               v8::NewStringType::kNormal,
+               static_cast<int>(text_.size())
+    )
+        .ToLocalChecked();
+  }
+
+  std::string path_;
+
+  // Written only by the worker until `done_` is ready
+  std::string text_;
+  bool oneByte_ = true;
+  bool readFailed_ = false;
+
+  v8::ScriptCompiler::StreamedSource source_;
+  std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> task_;
+  std::promise<void> finished_;
+  std::future<void> done_;
+};
@@ -2,30 +2,105 @@
 
 #include <v8.h>
 
+#include <array>
+#include <string_view>
+#include <vector>
+
 #include "bindings/CoffeeMachineBinding.h"
 #include "bindings/GlobalFunctions.h"
+#include "bindings/HostBinding.h"
 #include "bindings/RecipeBinding.h"
+#include "bindings/RecipeCatalogBinding.h"
+#include "bindings/WasmBinding.h"
 
+// Installs the native API into a context.
+//
+// Globals are registered as lazy data properties: the template and
+// constructor behind a name are only built the first time a script reads
+// it, after which V8 replaces the accessor with a plain data property.
+// Scripts that touch one or two classes no longer pay for all of them.
 class V8Bindings {
  public:
   V8Bindings(v8::Isolate *isolate, const v8::Local<v8::Context> context)
       : isolate_(isolate), context_(context) {}
 
-  void Initialize() const {
+  void Initialize() {
     v8::HandleScope handleScope(isolate_);
 
     // Get global object
     const auto global = context_->Global();
 
-    // Bind global functions (wait, console)
-    GlobalFunctions::Bind(isolate_, context_, global);
+    if (IsolateData::Get(isolate_)->clock()->isVirtual()) {
+      GlobalFunctions::InstallVirtualDate(isolate_, context_);
+    }
+
+    for (auto &binding : bindings_) {
+      global
+          ->SetLazyDataProperty(
+              context_,
+              v8::String::NewFromUtf8(isolate_, binding.name.data())
+                  .ToLocalChecked(),
+              materializeCallback,
+              v8::External::New(isolate_, &binding)
+          )
+          .Check();
+    }
+  }
 
-    // Bind all classes
-    CoffeeMachineBinding::Bind(isolate_, context_, global);
-    RecipeBinding::Bind(isolate_, context_, global);
+  // Names of the globals that scripts in this context have referenced so far
+  std::vector<std::string_view> materializedBindings() const {
+    std::vector<std::string_view> names;
+    for (const auto &binding : bindings_) {
+      if (binding.materialized) {
+        names.push_back(binding.name);
+      }
+    }
+    return names;
   }
 
  private:
+  using Factory =
+      v8::Local<v8::Value> (*)(v8::Isolate *, v8::Local<v8::Context>);
+
+  struct LazyBinding {
+    std::string_view name;
+    Factory factory;
+    bool materialized = false;
+  };
+
+  template <auto Create>
+  static v8::Local<v8::Value> factory(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
+  ) {
+    return Create(isolate, context);
+  }
+
+  static void materializeCallback(
+      v8::Local<v8::Name> /*property*/,
+      const v8::PropertyCallbackInfo<v8::Value> &info
+  ) {
+    auto *isolate = info.GetIsolate();
+    auto *binding =
+        static_cast<LazyBinding *>(info.Data().As<v8::External>()->Value());
+
+    binding->materialized = true;
+    info.GetReturnValue().Set(
+        binding->factory(isolate, isolate->GetCurrentContext())
+    );
+  }
+
   v8::Isolate *isolate_;
   v8::Local<v8::Context> context_;
+
+  // Every global exposed to scripts. Entries must not move once Initialize()
+  // has handed their addresses to V8.
+  std::array<LazyBinding, 7> bindings_{{
+      {"wait", factory<GlobalFunctions::CreateWait>},
+      {"console", factory<GlobalFunctions::CreateConsole>},
+      {"CoffeeMachine", factory<CoffeeMachineBinding::CreateConstructor>},
+      {"Recipe", factory<RecipeBinding::CreateConstructor>},
+      {"RecipeCatalog", factory<RecipeCatalogBinding::CreateConstructor>},
+      {"loadWasm", factory<WasmBinding::CreateLoadWasm>},
+      {"host", factory<HostBinding::CreateHost>},
+  }};
 };
@@ -1,26 +1,73 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
 #include <memory>
+#include <thread>
 
 #include <libplatform/libplatform.h>
 #include <v8.h>
 
+#include "WasmModuleCache.h"
+
+// Process-wide V8 initialization. One instance is shared by every
+// V8Runtime in the process and must outlive all of them.
 class V8Platform {
  public:
-  V8Platform() {
+  // `workerThreads` sizes the background pool used for concurrent GC and
+  // compilation; 0 lets V8 choose based on the number of cores.
+  // `wasmCacheDirectory` holds serialized WebAssembly modules between runs
+  // and must be private to the current user; an empty path disables the
+  // disk cache.
+  explicit V8Platform(
+      int workerThreads = 0,
+      std::filesystem::path wasmCacheDirectory =
+          WasmModuleCache::defaultDirectory()
+  )
+      : workerThreads_(poolSize(workerThreads)),
+        wasmCache_(std::move(wasmCacheDirectory)) {
     v8::V8::InitializeICUDefaultLocation("");
     v8::V8::InitializeExternalStartupData("");
 
-    platform_ = v8::platform::NewDefaultPlatform();
+    // Idle task support lets runtimes hand spare time to the GC
+    platform_ = v8::platform::NewDefaultPlatform(
+        static_cast<int>(workerThreads_),
+        v8::platform::IdleTaskSupport::kEnabled
+    );
     v8::V8::InitializePlatform(platform_.get());
     v8::V8::Initialize();
   }
 
   ~V8Platform() {
+    // Compiled modules reference engine state torn down by Dispose()
+    wasmCache_.clear();
+
     v8::V8::Dispose();
     v8::V8::DisposePlatform();
   }
 
+  V8Platform(const V8Platform&) = delete;
+  V8Platform& operator=(const V8Platform&) = delete;
+
+  v8::Platform* get() const noexcept { return platform_.get(); }
+
+  WasmModuleCache& wasmCache() noexcept { return wasmCache_; }
+
+  // Threads in the background pool
+  std::size_t workerThreads() const noexcept { return workerThreads_; }
+
  private:
+  // The size libplatform settles on: one fewer than the number of cores
+  // when unspecified, and always between 1 and 16
+  static std::size_t poolSize(int requested) {
+    if (requested <= 0) {
+      requested = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    return static_cast<std::size_t>(std::clamp(requested, 1, 16));
+  }
+
+  std::size_t workerThreads_;
   std::unique_ptr<v8::Platform> platform_;
+  WasmModuleCache wasmCache_;
 };
@@ -1,16 +1,44 @@
 #pragma once
 
+#include "HostEvent.h"
+#include "ScriptSource.h"
+#include "StreamedScript.h"
 #include "V8Bindings.h"
+#include "V8Platform.h"
+#include "bindings/HostBinding.h"
+#include "bindings/IsolateData.h"
+#include "utils/MpscQueue.h"
 
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <libplatform/libplatform.h>
 #include <v8.h>
 
+struct V8RuntimeOptions {
+  // Replace the wall clock with a deterministic virtual clock: brew() and
+  // wait() complete instantly and Date reports simulated time
+  bool virtualTime = false;
+
+  // Where the virtual clock starts, in milliseconds since the Unix epoch
+  int64_t virtualStartTime = 0;
+};
+
+// One isolate and context. Several runtimes may share a V8Platform; each
+// pumps its own isolate's foreground task queue.
 class V8Runtime {
  public:
-  V8Runtime() : isolate_(nullptr), allocator_(nullptr) {}
+  explicit V8Runtime(V8Platform& platform, V8RuntimeOptions options = {})
+      : platform_(platform),
+        options_(options),
+        isolate_(nullptr) {}
 
   ~V8Runtime() { cleanup(); }
 
@@ -18,10 +46,27 @@ class V8Runtime {
   void initialize() {
     // Create isolate with allocator
     v8::Isolate::CreateParams createParams;
-    allocator_ = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-    createParams.array_buffer_allocator = allocator_;
+    {
+      std::lock_guard<std::mutex> lock(allocatorMutex_);
+      allocator_.reset(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+    }
+    createParams.array_buffer_allocator_shared = allocator_;
     isolate_ = v8::Isolate::New(createParams);
 
+    // Fetched here because only the isolate thread may ask for it; posting
+    // to it is safe from any thread
+    taskRunner_ = platform_.get()->GetForegroundTaskRunner(isolate_);
+    isolateData_ = std::make_unique<IsolateData>(
+        isolate_,
+        createClock(),
+        platform_.wasmCache(),
+        platform_.workerThreads()
+    );
+
+    // Must be set before the context exists for V8 to install
+    // WebAssembly.compileStreaming
+    isolate_->SetWasmStreamingCallback(WasmBinding::StreamingCallback);
+
     // Initialize context and bindings within proper scopes
     initializeContextAndBindings();
   }
@@ -33,7 +78,99 @@ class V8Runtime {
       return false;
     }
 
-    return runScriptInContext(jsCode);
+    return runScriptInContext([&](const v8::Local<v8::Context> context) {
+      return v8::Script::Compile(
+          context,
+          v8::String::NewFromUtf8(isolate_, jsCode.c_str()).ToLocalChecked()
+      );
+    });
+  }
+
+  // Execute a file-backed script without copying its source onto the heap
+  bool executeScript(const ScriptSource& source) {
+    if (!isolate_) {
+      std::cerr << "V8 runtime not initialized!" << std::endl;
+      return false;
+    }
+
+    return runScriptInContext([&](const v8::Local<v8::Context> context) {
+      return v8::Script::Compile(context, source.toV8String(isolate_));
+    });
+  }
+
+  // Execute a script while it is still being read from `path` ("-" for
+  // stdin). Parsing and compilation run on a V8 worker thread as chunks
+  // arrive; this thread only finalizes the compiled script.
+  bool executeStreamedScript(const std::string& path) {
+    if (!isolate_) {
+      std::cerr << "V8 runtime not initialized!" << std::endl;
+      return false;
+    }
+
+    return runScriptInContext([&](const v8::Local<v8::Context> context) {
+      StreamedScript script(path);
+      script.start(isolate_, platform_.get());
+      return script.compile(context);
+    });
+  }
+
+  // Queue an event for the handlers scripts registered with host.on().
+  // Safe from any thread while the runtime is alive. Events are delivered
+  // in one batch per turn: after a script runs and on every
+  // pumpMessageLoop() or idle(). The first event into an empty queue also
+  // posts a foreground task, so a message loop blocked waiting for work
+  // wakes up to deliver it.
+  void postEvent(HostEvent event) {
+    if (events_.push(std::move(event))) {
+      taskRunner_->PostTask(std::make_unique<DeliverEventsTask>(*this));
+    }
+  }
+
+  // Uninitialized bytes that postEvent delivers as an ArrayBuffer without
+  // copying. Safe from any thread; throws unless the runtime is
+  // initialized.
+  EventBuffer createEventBuffer(std::size_t size) const {
+    std::shared_ptr<v8::ArrayBuffer::Allocator> allocator;
+    {
+      std::lock_guard<std::mutex> lock(allocatorMutex_);
+      allocator = allocator_;
+    }
+    if (!allocator) {
+      throw std::runtime_error("V8 runtime not initialized");
+    }
+    return EventBuffer(std::move(allocator), size);
+  }
+
+  // Run foreground tasks V8 has posted for this isolate (GC finalization,
+  // finished concurrent compiles) and deliver queued events without
+  // blocking
+  void pumpMessageLoop() {
+    if (!isolate_) {
+      return;
+    }
+
+    v8::Isolate::Scope isolateScope(isolate_);
+    v8::HandleScope handleScope(isolate_);
+    drainForegroundTasks();
+  }
+
+  // Hand V8 up to `budget` of idle time, e.g. between scripts, so idle-time
+  // GC work happens here instead of as pauses during execution
+  void idle(std::chrono::duration<double> budget) {
+    if (!isolate_) {
+      return;
+    }
+
+    v8::Isolate::Scope isolateScope(isolate_);
+    v8::HandleScope handleScope(isolate_);
+    drainForegroundTasks();
+    v8::platform::RunIdleTasks(platform_.get(), isolate_, budget.count());
+  }
+
+  // Globals that scripts have actually referenced, in registration order
+  std::vector<std::string_view> materializedBindings() const {
+    return bindings_ ? bindings_->materializedBindings()
+                     : std::vector<std::string_view>{};
   }
 
   // Clean up resources in correct order
@@ -43,23 +180,48 @@ class V8Runtime {
       context_.Reset();
     }
 
-    // Reset bindings before isolate disposal
+    // Undelivered events hold memory V8 no longer needs
+    events_.drain();
+
+    // Reset bindings and cached templates before isolate disposal
     bindings_.reset();
+    isolateData_.reset();
 
-    // Dispose isolate
+    // Dispose isolate, dropping any tasks still queued for it
     if (isolate_) {
+      v8::platform::NotifyIsolateShutdown(platform_.get(), isolate_);
       isolate_->Dispose();
       isolate_ = nullptr;
     }
+    taskRunner_.reset();
 
-    // Delete allocator last
-    if (allocator_) {
-      delete allocator_;
-      allocator_ = nullptr;
-    }
+    // Release our allocator reference last; outstanding EventBuffers keep
+    // it alive until they are freed
+    std::lock_guard<std::mutex> lock(allocatorMutex_);
+    allocator_.reset();
   }
 
  private:
+  // Posted by postEvent. Runs inside PumpMessageLoop, where the isolate is
+  // entered, and never outlives the runtime: cleanup() drops queued tasks
+  // before the runtime goes away.
+  class DeliverEventsTask : public v8::Task {
+   public:
+    explicit DeliverEventsTask(V8Runtime& runtime) : runtime_(runtime) {}
+
+    void Run() override { runtime_.deliverEvents(); }
+
+   private:
+    V8Runtime& runtime_;
+  };
+
+  std::shared_ptr<Clock> createClock() const {
+    if (options_.virtualTime) {
+      return std::make_shared<VirtualClock>(options_.virtualStartTime);
+    }
+    return std::make_shared<RealClock>();
+  }
+
   void initializeContextAndBindings() {
     v8::Isolate::Scope isolateScope(isolate_);
     v8::HandleScope handleScope(isolate_);
@@ -74,31 +236,74 @@ class V8Runtime {
     bindings_->Initialize();
   }
 
-  bool runScriptInContext(const std::string& jsCode) {
+  // `compile` runs inside the isolate, handle and context scopes
+  template <typename Compiler>
+  bool runScriptInContext(Compiler&& compile) {
     v8::Isolate::Scope isolateScope(isolate_);
     v8::HandleScope handleScope(isolate_);
     const v8::Local<v8::Context> context = context_.Get(isolate_);
     v8::Context::Scope contextScope(context);
 
     try {
-      return compileAndExecute(context, jsCode);
+      const bool succeeded = execute(context, compile(context));
+
+      // Run what V8 posted while the script was executing, then wait for
+      // work that settles the script's promises later
+      drainForegroundTasks();
+      waitForPendingLoads();
+      return succeeded;
     } catch (const std::exception& e) {
       std::cerr << "Error: " << e.what() << std::endl;
       return false;
     }
   }
 
-  bool compileAndExecute(
-      v8::Local<v8::Context> context, const std::string& jsCode
+  // One turn: every ready foreground task, then the events posted so far,
+  // then the microtasks both queued. Assumes the isolate is entered.
+  void drainForegroundTasks() {
+    while (v8::platform::PumpMessageLoop(platform_.get(), isolate_)) {
+    }
+    deliverEvents();
+    isolate_->PerformMicrotaskCheckpoint();
+  }
+
+  // Blocks on the task queue while loadWasm() compiles are in flight; each
+  // one finishes by posting a foreground task, as does an event posted
+  // meanwhile. Assumes the isolate is entered.
+  void waitForPendingLoads() {
+    while (isolateData_->pendingWasmLoads() > 0) {
+      v8::platform::PumpMessageLoop(
+          platform_.get(),
+          isolate_,
+          v8::platform::MessageLoopBehavior::kWaitForWork
+      );
+      drainForegroundTasks();
+    }
+  }
+
+  void deliverEvents() {
+    if (events_.empty()) {
+      return;
+    }
+
+    v8::HandleScope handleScope(isolate_);
+    const v8::Local<v8::Context> context = context_.Get(isolate_);
+    v8::Context::Scope contextScope(context);
+    HostBinding::Dispatch(isolate_, context, events_.drain());
+  }
+
+  bool execute(
+      v8::Local<v8::Context> context, const v8::MaybeLocal<v8::Script> compiled
   ) const {
+    v8::Local<v8::Script> script;
+    if (!compiled.ToLocal(&script)) {
+      std::cerr << "Script compilation failed!" << std::endl;
+      return false;
+    }
+
     std::cout << "\nRunning script:\n" << std::endl;
     std::cout << "================================" << std::endl;
 
-    const v8::Local<v8::String> source =
-        v8::String::NewFromUtf8(isolate_, jsCode.c_str()).ToLocalChecked();
-    const v8::Local<v8::Script> script =
-        v8::Script::Compile(context, source).ToLocalChecked();
-
     if (const v8::Local<v8::Value> result =
             script->Run(context).ToLocalChecked();
         result.IsEmpty()) {
@@ -111,8 +316,14 @@ class V8Runtime {
     return true;
   }
 
+  V8Platform& platform_;
+  V8RuntimeOptions options_;
   v8::Isolate* isolate_;
+  std::shared_ptr<v8::TaskRunner> taskRunner_;
   v8::Persistent<v8::Context> context_;
   std::unique_ptr<V8Bindings> bindings_;
-  v8::ArrayBuffer::Allocator* allocator_;
+  std::unique_ptr<IsolateData> isolateData_;
+  std::shared_ptr<v8::ArrayBuffer::Allocator> allocator_;
+  mutable std::mutex allocatorMutex_;
+  MpscQueue<HostEvent> events_;
 };
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <v8.h>
+
+// Compiled WebAssembly modules, cached at two levels.
+//
+// In process, compiled modules are kept by key and re-created in any isolate
+// with WasmModuleObject::FromCompiledModule, which shares the machine code
+// instead of compiling again. On disk, modules are stored in V8's
+// serialized form so the next process start can skip compilation as well.
+//
+// Keys combine a hash of the wire bytes, their size and the V8 version, so
+// a changed module or engine upgrade never picks up stale code. V8 also
+// validates serialized data itself and silently recompiles on mismatch.
+//
+// Serialized modules are machine code that V8 loads without recompiling,
+// so the disk cache is only used while its directory is private: owned by
+// the effective user and closed to group and others. A directory anyone
+// else could write to is ignored.
+//
+// Owned by V8Platform: compiled modules must be released before V8 is
+// disposed.
+class WasmModuleCache {
+ public:
+  // An empty directory disables the disk cache
+  explicit WasmModuleCache(std::filesystem::path directory)
+      : directory_(std::move(directory)) {
+    if (!directory_.empty() && !directory_.has_filename()) {
+      directory_ = directory_.parent_path();  // Drop a trailing separator
+    }
+  }
+
+  WasmModuleCache(const WasmModuleCache &) = delete;
+  WasmModuleCache &operator=(const WasmModuleCache &) = delete;
+
+  // Per-user cache location: $XDG_CACHE_HOME/v8_demo/wasm, falling back to
+  // ~/.cache/v8_demo/wasm. Empty, disabling the disk cache, if neither
+  // variable is usable.
+  static std::filesystem::path defaultDirectory() {
+    std::filesystem::path base;
+    if (const char *cache = std::getenv("XDG_CACHE_HOME");
+        cache && std::filesystem::path(cache).is_absolute()) {
+      base = cache;
+    } else if (const char *home = std::getenv("HOME");
+               home && std::filesystem::path(home).is_absolute()) {
+      base = std::filesystem::path(home) / ".cache";
+    } else {
+      return {};
+    }
+    return base / "v8_demo" / "wasm";
+  }
+
+  static std::string keyFor(std::string_view wireBytes) {
+    char key[64];
+    std::snprintf(
+        key,
+        sizeof(key),
+        "%016llx-%zu-",
+        static_cast<unsigned long long>(hash(wireBytes)),
+        wireBytes.size()
+    );
+    return key + std::string(v8::V8::GetVersion());
+  }
+
+  // Compiled module for `key`, if this process has built one. The wire
+  // bytes are compared as well, so a hash collision can only cost a miss.
+  std::shared_ptr<v8::CompiledWasmModule> find(
+      const std::string &key, std::string_view wireBytes
+  ) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = modules_.find(key);
+    if (it == modules_.end()) {
+      return nullptr;
+    }
+
+    const auto cached = it->second->GetWireBytesRef();
+    if (cached.size() != wireBytes.size() ||
+        std::memcmp(cached.data(), wireBytes.data(), cached.size()) != 0) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  // Makes `module` available to every isolate, and writes it to disk the
+  // first time it is seen
+  void remember(const std::string &key, const v8::CompiledWasmModule &module) {
+    auto shared = std::make_shared<v8::CompiledWasmModule>(module);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!modules_.try_emplace(key, shared).second) {
+        return;
+      }
+    }
+
+    if (isPrivate() && !std::filesystem::exists(fileFor(key))) {
+      writeSerialized(key, *shared);
+    }
+  }
+
+  // Serialized module from a previous run, if any
+  std::optional<std::vector<uint8_t>> readSerialized(const std::string &key
+  ) const {
+    if (!isPrivate()) {
+      return std::nullopt;
+    }
+
+    std::ifstream file(fileFor(key), std::ios::binary);
+    if (!file.is_open()) {
+      return std::nullopt;
+    }
+    return std::vector<uint8_t>(
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>()
+    );
+  }
+
+  // Replaces the on-disk entry for `key`. May be called from V8 background
+  // threads as tier-up makes more optimized code available. Writes go to a
+  // temporary file and are renamed into place, so readers never see a
+  // partial entry.
+  void writeSerialized(const std::string &key, v8::CompiledWasmModule module)
+      const {
+    if (!createPrivateDirectory()) {
+      return;
+    }
+
+    const v8::OwnedBuffer serialized = module.Serialize();
+    if (serialized.size == 0) {
+      return;
+    }
+
+    std::error_code error;
+
+    const auto target = fileFor(key);
+    auto temporary = target;
+    temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(
+                              std::this_thread::get_id()
+                          ));
+    {
+      std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+      if (!file.write(
+              reinterpret_cast<const char *>(serialized.buffer.get()),
+              static_cast<std::streamsize>(serialized.size)
+          )) {
+        std::filesystem::remove(temporary, error);
+        return;
+      }
+    }
+    std::filesystem::rename(temporary, target, error);
+  }
+
+  // Releases every compiled module held in memory
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    modules_.clear();
+  }
+
+ private:
+  // Whether the directory exists, is a real directory rather than a link,
+  // belongs to the effective user and has no group or other permissions
+  bool isPrivate() const {
+    struct stat info;
+    return !directory_.empty() && ::lstat(directory_.c_str(), &info) == 0 &&
+           S_ISDIR(info.st_mode) && info.st_uid == ::geteuid() &&
+           (info.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+  }
+
+  // Creates the directory with mode 0700 if it is missing. Parents get the
+  // usual permissions; an existing directory is never loosened or
+  // tightened, only checked.
+  bool createPrivateDirectory() const {
+    if (directory_.empty()) {
+      return false;
+    }
+
+    std::error_code error;
+    if (directory_.has_parent_path()) {
+      std::filesystem::create_directories(directory_.parent_path(), error);
+    }
+    // mkdir applies the umask, which can only remove permissions
+    ::mkdir(directory_.c_str(), S_IRWXU);
+    return isPrivate();
+  }
+
+  std::filesystem::path fileFor(const std::string &key) const {
+    return directory_ / (key + ".wasmcache");
+  }
+
+  // FNV-1a over 64-bit words; only used to name cache entries
+  static uint64_t hash(std::string_view bytes) noexcept {
+    constexpr uint64_t kPrime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, bytes.data() + i, sizeof(word));
+      hash = (hash ^ word) * kPrime;
+    }
+    for (; i < bytes.size(); ++i) {
+      hash = (hash ^ static_cast<unsigned char>(bytes[i])) * kPrime;
+    }
+    return hash;
+  }
+
+  std::filesystem::path directory_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<v8::CompiledWasmModule>>
+      modules_;
+};
@@ -5,14 +5,25 @@
 
 #include "../models/CoffeeMachine.h"
 #include "../models/Recipe.h"
+#include "IsolateData.h"
 #include "V8ObjectWrapper.h"
 
 class CoffeeMachineBinding {
  public:
-  static void Bind(
-      v8::Isolate *isolate, const v8::Local<v8::Context> context,
-      const v8::Local<v8::Object> global
+  // Returns the CoffeeMachine constructor for `context`. Called once per
+  // context, the first time a script references `CoffeeMachine`.
+  static v8::Local<v8::Function> CreateConstructor(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
   ) {
+    return IsolateData::Get(isolate)
+        ->classTemplate<CoffeeMachineBinding>()
+        ->GetFunction(context)
+        .ToLocalChecked();
+  }
+
+  // Builds the CoffeeMachine class. Called once per isolate through
+  // IsolateData.
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate *isolate) {
     const auto coffeeTemplate = v8::FunctionTemplate::New(isolate);
     coffeeTemplate->SetClassName(
         v8::String::NewFromUtf8(isolate, "CoffeeMachine").ToLocalChecked()
@@ -31,7 +42,10 @@ class CoffeeMachineBinding {
               name = *str;
             }
 
-            const auto machine = std::make_shared<CoffeeMachine>(name);
+            const auto machine = std::make_shared<CoffeeMachine>(
+                name,
+                IsolateData::Get(isolate)->clock()
+            );
             V8ObjectWrapper<CoffeeMachine>::wrap(args.This(), machine);
             args.GetReturnValue().Set(args.This());
           }
@@ -40,7 +54,9 @@ class CoffeeMachineBinding {
 
     // Instance template
     const auto instanceTemplate = coffeeTemplate->InstanceTemplate();
-    instanceTemplate->SetInternalFieldCount(1);
+    instanceTemplate->SetInternalFieldCount(
+        V8ObjectWrapper<CoffeeMachine>::kInternalFieldCount
+    );
 
     // Methods
     instanceTemplate->Set(
@@ -49,7 +65,7 @@ class CoffeeMachineBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto machine =
-                      V8ObjectWrapper<CoffeeMachine>::unwrap(args.This())) {
+                      V8ObjectWrapper<CoffeeMachine>::borrow(args.This())) {
                 machine->turnOn();
               }
             }
@@ -62,7 +78,7 @@ class CoffeeMachineBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto machine =
-                      V8ObjectWrapper<CoffeeMachine>::unwrap(args.This())) {
+                      V8ObjectWrapper<CoffeeMachine>::borrow(args.This())) {
                 machine->turnOff();
               }
             }
@@ -80,7 +96,7 @@ class CoffeeMachineBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto machine =
-                      V8ObjectWrapper<CoffeeMachine>::unwrap(args.This())) {
+                      V8ObjectWrapper<CoffeeMachine>::borrow(args.This())) {
                 args.GetReturnValue().Set(
                     v8::String::NewFromUtf8(
                         args.GetIsolate(),
@@ -93,14 +109,7 @@ class CoffeeMachineBinding {
         )
     );
 
-    // Set constructor to global
-    global
-        ->Set(
-            context,
-            v8::String::NewFromUtf8(isolate, "CoffeeMachine").ToLocalChecked(),
-            coffeeTemplate->GetFunction(context).ToLocalChecked()
-        )
-        .Check();
+    return coffeeTemplate;
   }
 
  private:
@@ -109,17 +118,16 @@ class CoffeeMachineBinding {
     v8::HandleScope scope(isolate);
     const auto context = isolate->GetCurrentContext();
 
-    const auto machine = V8ObjectWrapper<CoffeeMachine>::unwrap(args.This());
+    const auto machine = V8ObjectWrapper<CoffeeMachine>::borrow(args.This());
     if (!machine) {
       args.GetReturnValue().SetUndefined();
       return;
     }
 
-    // Extract Recipe from argument
-    std::shared_ptr<Recipe> recipe;
+    // Extract Recipe from argument; any other object is rejected below
+    const Recipe *recipe = nullptr;
     if (args.Length() > 0 && args[0]->IsObject()) {
-      const auto recipeObj = args[0].As<v8::Object>();
-      recipe = V8ObjectWrapper<Recipe>::unwrap(recipeObj);
+      recipe = V8ObjectWrapper<Recipe>::borrow(args[0].As<v8::Object>());
     }
 
     // Create and return a Promise
@@ -3,26 +3,74 @@
 #include <v8.h>
 #include <chrono>
 #include <iostream>
-#include <thread>
+
+#include "IsolateData.h"
 
 class GlobalFunctions {
  public:
-  static void Bind(
-      v8::Isolate *isolate, const v8::Local<v8::Context> context,
-      const v8::Local<v8::Object> global
+  // wait() function - returns a Promise that resolves after specified
+  // milliseconds
+  static v8::Local<v8::Function> CreateWait(
+      v8::Isolate * /*isolate*/, const v8::Local<v8::Context> context
+  ) {
+    return v8::Function::New(context, waitCallback).ToLocalChecked();
+  }
+
+  // console object with log()
+  static v8::Local<v8::Object> CreateConsole(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
   ) {
-    // wait() function - returns a Promise that resolves after specified
-    // milliseconds
-    global
+    const auto console = v8::Object::New(isolate);
+
+    // console.log implementation with proper object serialization
+    console
         ->Set(
             context,
-            v8::String::NewFromUtf8(isolate, "wait").ToLocalChecked(),
-            v8::Function::New(context, waitCallback).ToLocalChecked()
+            v8::String::NewFromUtf8(isolate, "log").ToLocalChecked(),
+            v8::Function::New(context, consoleLogCallback).ToLocalChecked()
         )
         .Check();
 
-    // Setup console object
-    setupConsole(isolate, context, global);
+    return console;
+  }
+
+  // Points Date.now(), new Date() and Date() at the isolate's virtual
+  // clock; dates built from explicit arguments are unaffected. Installed
+  // eagerly because Date is a builtin, not one of our lazy globals.
+  static void InstallVirtualDate(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
+  ) {
+    // A proxy keeps instanceof, subclassing and the static methods intact
+    constexpr const char *kInstall = R"((function (now) {
+  const RealDate = Date;
+  const VirtualDate = new Proxy(RealDate, {
+    construct(target, args, newTarget) {
+      const time = args.length > 0 ? args : [now()];
+      return Reflect.construct(target, time, newTarget);
+    },
+    apply() {
+      return String(new RealDate(now()));
+    },
+  });
+  RealDate.now = now;
+  RealDate.prototype.constructor = VirtualDate;
+  globalThis.Date = VirtualDate;
+}))";
+
+    const auto install =
+        v8::Script::Compile(
+            context,
+            v8::String::NewFromUtf8(isolate, kInstall).ToLocalChecked()
+        )
+            .ToLocalChecked()
+            ->Run(context)
+            .ToLocalChecked()
+            .As<v8::Function>();
+
+    v8::Local<v8::Value> argv[] = {
+        v8::Function::New(context, dateNowCallback).ToLocalChecked()
+    };
+    install->Call(context, context->Global(), 1, argv).ToLocalChecked();
   }
 
  private:
@@ -41,36 +89,22 @@ class GlobalFunctions {
     // Create Promise
     const auto resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
 
-    // Simulate async wait with synchronous sleep
-    // Note: In production, this should be integrated with an event loop
-    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    // Simulate async wait with synchronous sleep; a virtual clock just
+    // advances. Note: In production, this should be integrated with an
+    // event loop
+    IsolateData::Get(isolate)->clock()->sleepFor(
+        std::chrono::milliseconds(milliseconds)
+    );
     resolver->Resolve(context, v8::Undefined(isolate)).Check();
 
     args.GetReturnValue().Set(resolver->GetPromise());
   }
 
-  static void setupConsole(
-      v8::Isolate *isolate, const v8::Local<v8::Context> context,
-      const v8::Local<v8::Object> global
+  static void dateNowCallback(const v8::FunctionCallbackInfo<v8::Value> &args
   ) {
-    const auto console = v8::Object::New(isolate);
-
-    // console.log implementation with proper object serialization
-    console
-        ->Set(
-            context,
-            v8::String::NewFromUtf8(isolate, "log").ToLocalChecked(),
-            v8::Function::New(context, consoleLogCallback).ToLocalChecked()
-        )
-        .Check();
-
-    global
-        ->Set(
-            context,
-            v8::String::NewFromUtf8(isolate, "console").ToLocalChecked(),
-            console
-        )
-        .Check();
+    args.GetReturnValue().Set(
+        IsolateData::Get(args.GetIsolate())->clock()->now()
+    );
   }
 
   static void consoleLogCallback(
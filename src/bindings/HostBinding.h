@@ -0,0 +1,172 @@
+#pragma once
+
+#include <v8.h>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../HostEvent.h"
+#include "IsolateData.h"
+
+// The `host` global: scripts subscribe with host.on(type, fn), and events
+// posted through V8Runtime::postEvent are delivered by Dispatch.
+//
+// Each handler is called once per batch with an array of that type's
+// payloads in posting order, rather than once per event. Types are
+// dispatched in the order they first appear in the batch, and payloads of
+// types nobody listens to are never converted.
+class HostBinding {
+ public:
+  static v8::Local<v8::Object> CreateHost(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
+  ) {
+    const auto host = v8::Object::New(isolate);
+    host->Set(
+            context,
+            v8::String::NewFromUtf8(isolate, "on").ToLocalChecked(),
+            v8::Function::New(context, onCallback).ToLocalChecked()
+    )
+        .Check();
+    return host;
+  }
+
+  // Delivers one batch. Must be called with `context` entered.
+  static void Dispatch(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context,
+      std::vector<HostEvent> batch
+  ) {
+    if (batch.empty()) {
+      return;
+    }
+
+    v8::HandleScope scope(isolate);
+    const auto *data = IsolateData::Get(isolate);
+
+    struct Group {
+      std::string_view type;
+      std::vector<v8::Local<v8::Function>> handlers;
+      std::vector<v8::Local<v8::Value>> payloads;
+    };
+    std::vector<Group> groups;
+    std::unordered_map<std::string_view, std::size_t> groupOf;
+
+    for (auto &event : batch) {
+      const auto [it, inserted] =
+          groupOf.try_emplace(event.type, groups.size());
+      if (inserted) {
+        groups.push_back({event.type, data->eventHandlers(event.type), {}});
+      }
+
+      auto &group = groups[it->second];
+      if (group.handlers.empty()) {
+        continue;
+      }
+
+      v8::TryCatch tryCatch(isolate);
+      v8::Local<v8::Value> payload;
+      if (toValue(isolate, context, event.payload).ToLocal(&payload)) {
+        group.payloads.push_back(payload);
+      } else {
+        report(isolate, tryCatch, event.type);
+      }
+    }
+
+    for (auto &group : groups) {
+      if (group.payloads.empty()) {
+        continue;
+      }
+
+      v8::Local<v8::Value> argv[] = {v8::Array::New(
+          isolate,
+          group.payloads.data(),
+          group.payloads.size()
+      )};
+      for (const auto &handler : group.handlers) {
+        v8::TryCatch tryCatch(isolate);
+        if (handler->Call(context, v8::Undefined(isolate), 1, argv)
+                .IsEmpty()) {
+          report(isolate, tryCatch, group.type);
+        }
+      }
+    }
+  }
+
+ private:
+  static void onCallback(const v8::FunctionCallbackInfo<v8::Value> &args) {
+    auto *isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+
+    if (args.Length() < 2 || !args[0]->IsString() || !args[1]->IsFunction()) {
+      isolate->ThrowException(v8::Exception::TypeError(
+          v8::String::NewFromUtf8(
+              isolate,
+              "host.on expects an event type and a handler"
+          )
+              .ToLocalChecked()
+      ));
+      return;
+    }
+
+    const v8::String::Utf8Value type(isolate, args[0]);
+    IsolateData::Get(isolate)->addEventHandler(
+        std::string(*type, type.length()),
+        args[1].As<v8::Function>()
+    );
+  }
+
+  // Numbers and bytes are handed over as they are; anything structured
+  // goes through a ValueDeserializer
+  static v8::MaybeLocal<v8::Value> toValue(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context,
+      HostEvent::Payload &payload
+  ) {
+    if (const auto *number = std::get_if<double>(&payload)) {
+      return v8::Number::New(isolate, *number);
+    }
+    if (const auto *text = std::get_if<std::string>(&payload)) {
+      v8::Local<v8::String> string;
+      if (!v8::String::NewFromUtf8(
+               isolate,
+               text->data(),
+               v8::NewStringType::kNormal,
+               static_cast<int>(text->size())
+      )
+               .ToLocal(&string)) {
+        return {};
+      }
+      return string;
+    }
+    if (auto *buffer = std::get_if<EventBuffer>(&payload)) {
+      return buffer->toArrayBuffer(isolate);
+    }
+    if (const auto *serialized = std::get_if<SerializedValue>(&payload)) {
+      v8::ValueDeserializer deserializer(
+          isolate,
+          serialized->bytes.data(),
+          serialized->bytes.size()
+      );
+      if (!deserializer.ReadHeader(context).FromMaybe(false)) {
+        return {};
+      }
+      return deserializer.ReadValue(context);
+    }
+    return v8::Undefined(isolate);
+  }
+
+  static void report(
+      v8::Isolate *isolate, const v8::TryCatch &tryCatch,
+      const std::string_view type
+  ) {
+    std::cerr << "Error in host event '" << type << "'";
+    if (tryCatch.HasCaught()) {
+      const v8::String::Utf8Value message(isolate, tryCatch.Exception());
+      std::cerr << ": " << (*message ? *message : "<unknown>");
+    }
+    std::cerr << std::endl;
+  }
+};
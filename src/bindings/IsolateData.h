@@ -0,0 +1,142 @@
+#pragma once
+
+#include <v8.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "../WasmModuleCache.h"
+#include "../models/Clock.h"
+
+// Per-isolate state shared by the bindings, reachable from any callback
+// through the isolate's embedder data slot.
+//
+// Owned by V8Runtime and destroyed before the isolate is disposed, so the
+// handles it holds never outlive their heap.
+class IsolateData {
+ public:
+  static constexpr uint32_t kSlot = 0;
+
+  IsolateData(
+      v8::Isolate *isolate, std::shared_ptr<Clock> clock,
+      WasmModuleCache &wasmCache, std::size_t workerThreads
+  )
+      : isolate_(isolate),
+        clock_(std::move(clock)),
+        wasmCache_(wasmCache),
+        workerThreads_(workerThreads) {
+    isolate_->SetData(kSlot, this);
+  }
+
+  ~IsolateData() { isolate_->SetData(kSlot, nullptr); }
+
+  IsolateData(const IsolateData &) = delete;
+  IsolateData &operator=(const IsolateData &) = delete;
+
+  static IsolateData *Get(v8::Isolate *isolate) {
+    return static_cast<IsolateData *>(isolate->GetData(kSlot));
+  }
+
+  // Time source for everything scripts can wait on
+  const std::shared_ptr<Clock> &clock() const noexcept { return clock_; }
+
+  // Process-wide compiled WebAssembly modules
+  WasmModuleCache &wasmCache() const noexcept { return wasmCache_; }
+
+  // Size of the platform's background pool, which native work started
+  // from scripts should not exceed
+  std::size_t workerThreads() const noexcept { return workerThreads_; }
+
+  // loadWasm() compiles still running on worker threads. The runtime keeps
+  // pumping tasks until this is zero so their promises settle.
+  int pendingWasmLoads() const noexcept { return pendingWasmLoads_; }
+
+  void beginWasmLoad() noexcept { ++pendingWasmLoads_; }
+
+  void endWasmLoad() noexcept { --pendingWasmLoads_; }
+
+  // Class template for `Binding`, built once per isolate by
+  // Binding::CreateTemplate. Reusing it keeps constructors created in
+  // different contexts and objects wrapped from native code the same class.
+  template <typename Binding>
+  v8::Local<v8::FunctionTemplate> classTemplate() {
+    auto &cached = templates_[std::type_index(typeid(Binding))];
+    if (cached.IsEmpty()) {
+      cached.Reset(isolate_, Binding::CreateTemplate(isolate_));
+    }
+    return cached.Get(isolate_);
+  }
+
+  // JS object previously registered for `native`, or an empty handle if
+  // there is none or it has been garbage collected
+  v8::Local<v8::Object> findWrapper(const void *native) {
+    const auto it = wrappers_.find(native);
+    if (it == wrappers_.end()) {
+      return {};
+    }
+    if (it->second.IsEmpty()) {
+      wrappers_.erase(it);
+      return {};
+    }
+    return it->second.Get(isolate_);
+  }
+
+  // Remembers `jsObject` as the wrapper for `native` without keeping it
+  // alive. The wrapper owns the native object, so the address cannot be
+  // reused while the entry is live.
+  void rememberWrapper(const void *native, v8::Local<v8::Object> jsObject) {
+    if (wrappers_.size() >= pruneThreshold_) {
+      pruneWrappers();
+    }
+
+    auto &handle = wrappers_[native];
+    handle.Reset(isolate_, jsObject);
+    handle.SetWeak();
+  }
+
+  // Registers a host.on() handler for events of `type`
+  void addEventHandler(std::string type, v8::Local<v8::Function> handler) {
+    eventHandlers_[std::move(type)].emplace_back(isolate_, handler);
+  }
+
+  // Handlers for `type` in registration order. A snapshot, so handlers may
+  // register others while being called.
+  std::vector<v8::Local<v8::Function>> eventHandlers(const std::string &type
+  ) const {
+    std::vector<v8::Local<v8::Function>> handlers;
+    if (const auto it = eventHandlers_.find(type); it != eventHandlers_.end()) {
+      handlers.reserve(it->second.size());
+      for (const auto &handler : it->second) {
+        handlers.push_back(handler.Get(isolate_));
+      }
+    }
+    return handlers;
+  }
+
+ private:
+  // Drops entries whose objects were collected. The threshold doubles with
+  // the live set so pruning stays amortized O(1) per insertion.
+  void pruneWrappers() {
+    std::erase_if(wrappers_, [](const auto &entry) {
+      return entry.second.IsEmpty();
+    });
+    pruneThreshold_ = std::max<std::size_t>(1024, wrappers_.size() * 2);
+  }
+
+  v8::Isolate *isolate_;
+  std::shared_ptr<Clock> clock_;
+  WasmModuleCache &wasmCache_;
+  std::size_t workerThreads_;
+  std::unordered_map<std::type_index, v8::Global<v8::FunctionTemplate>>
+      templates_;
+  std::unordered_map<const void *, v8::Global<v8::Object>> wrappers_;
+  std::size_t pruneThreshold_ = 1024;
+  int pendingWasmLoads_ = 0;
+  std::unordered_map<std::string, std::vector<v8::Global<v8::Function>>>
+      eventHandlers_;
+};
@@ -4,14 +4,46 @@
 #include <memory>
 
 #include "../models/Recipe.h"
+#include "IsolateData.h"
 #include "V8ObjectWrapper.h"
 
 class RecipeBinding {
  public:
-  static void Bind(
+  // Returns the Recipe constructor for `context`. Called once per
+  // context, the first time a script references `Recipe`.
+  static v8::Local<v8::Function> CreateConstructor(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
+  ) {
+    return IsolateData::Get(isolate)
+        ->classTemplate<RecipeBinding>()
+        ->GetFunction(context)
+        .ToLocalChecked();
+  }
+
+  // Returns the JS object for a native recipe. A recipe that already has a
+  // live wrapper gets the same object back, so shared recipes keep a single
+  // identity in scripts.
+  static v8::Local<v8::Object> Wrap(
       v8::Isolate *isolate, const v8::Local<v8::Context> context,
-      const v8::Local<v8::Object> global
+      const std::shared_ptr<Recipe> &recipe
   ) {
+    auto *data = IsolateData::Get(isolate);
+    if (const auto existing = data->findWrapper(recipe.get());
+        !existing.IsEmpty()) {
+      return existing;
+    }
+
+    const auto object = data->classTemplate<RecipeBinding>()
+                            ->InstanceTemplate()
+                            ->NewInstance(context)
+                            .ToLocalChecked();
+    V8ObjectWrapper<Recipe>::wrap(object, recipe);
+    data->rememberWrapper(recipe.get(), object);
+    return object;
+  }
+
+  // Builds the Recipe class. Called once per isolate through IsolateData.
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate *isolate) {
     const auto recipeTemplate = v8::FunctionTemplate::New(isolate);
     recipeTemplate->SetClassName(
         v8::String::NewFromUtf8(isolate, "Recipe").ToLocalChecked()
@@ -54,7 +86,9 @@ class RecipeBinding {
 
     // Instance template
     const auto instanceTemplate = recipeTemplate->InstanceTemplate();
-    instanceTemplate->SetInternalFieldCount(1);
+    instanceTemplate->SetInternalFieldCount(
+        V8ObjectWrapper<Recipe>::kInternalFieldCount
+    );
 
     // Methods
     instanceTemplate->Set(
@@ -63,7 +97,7 @@ class RecipeBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto recipe =
-                      V8ObjectWrapper<Recipe>::unwrap(args.This())) {
+                      V8ObjectWrapper<Recipe>::borrow(args.This())) {
                 args.GetReturnValue().Set(
                     v8::String::NewFromUtf8(
                         args.GetIsolate(),
@@ -82,7 +116,7 @@ class RecipeBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto recipe =
-                      V8ObjectWrapper<Recipe>::unwrap(args.This())) {
+                      V8ObjectWrapper<Recipe>::borrow(args.This())) {
                 args.GetReturnValue().Set(recipe->getStrength());
               }
             }
@@ -95,7 +129,7 @@ class RecipeBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto recipe =
-                      V8ObjectWrapper<Recipe>::unwrap(args.This())) {
+                      V8ObjectWrapper<Recipe>::borrow(args.This())) {
                 args.GetReturnValue().Set(recipe->getBrewTime());
               }
             }
@@ -108,7 +142,7 @@ class RecipeBinding {
             isolate,
             [](const v8::FunctionCallbackInfo<v8::Value> &args) {
               if (const auto recipe =
-                      V8ObjectWrapper<Recipe>::unwrap(args.This())) {
+                      V8ObjectWrapper<Recipe>::borrow(args.This())) {
                 args.GetReturnValue().Set(
                     v8::String::NewFromUtf8(
                         args.GetIsolate(),
@@ -121,13 +155,6 @@ class RecipeBinding {
         )
     );
 
-    // Set constructor to global
-    global
-        ->Set(
-            context,
-            v8::String::NewFromUtf8(isolate, "Recipe").ToLocalChecked(),
-            recipeTemplate->GetFunction(context).ToLocalChecked()
-        )
-        .Check();
+    return recipeTemplate;
   }
 };
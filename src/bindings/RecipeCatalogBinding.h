@@ -0,0 +1,185 @@
+#pragma once
+
+#include <v8.h>
+#include <climits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../models/RecipeCatalog.h"
+#include "IsolateData.h"
+#include "RecipeBinding.h"
+#include "V8ObjectWrapper.h"
+
+class RecipeCatalogBinding {
+ public:
+  // Returns the RecipeCatalog constructor for `context`. Called once per
+  // context, the first time a script references `RecipeCatalog`.
+  static v8::Local<v8::Function> CreateConstructor(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context
+  ) {
+    return IsolateData::Get(isolate)
+        ->classTemplate<RecipeCatalogBinding>()
+        ->GetFunction(context)
+        .ToLocalChecked();
+  }
+
+  // Builds the RecipeCatalog class. Called once per isolate through
+  // IsolateData.
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate *isolate) {
+    const auto catalogTemplate = v8::FunctionTemplate::New(isolate);
+    catalogTemplate->SetClassName(
+        v8::String::NewFromUtf8(isolate, "RecipeCatalog").ToLocalChecked()
+    );
+
+    // Constructor, optionally loading a file straight away
+    catalogTemplate->SetCallHandler(
+        [](const v8::FunctionCallbackInfo<v8::Value> &args) {
+          auto *isolate = args.GetIsolate();
+          v8::HandleScope scope(isolate);
+
+          if (args.IsConstructCall()) {
+            // Parse with no more threads than the V8 worker pool has
+            const auto catalog = std::make_shared<RecipeCatalog>(
+                IsolateData::Get(isolate)->workerThreads()
+            );
+            if (args.Length() > 0 && args[0]->IsString() &&
+                !loadInto(isolate, *catalog, args[0])) {
+              return;  // Error already thrown
+            }
+
+            V8ObjectWrapper<RecipeCatalog>::wrap(args.This(), catalog);
+            args.GetReturnValue().Set(args.This());
+          }
+        }
+    );
+
+    // Instance template
+    const auto instanceTemplate = catalogTemplate->InstanceTemplate();
+    instanceTemplate->SetInternalFieldCount(
+        V8ObjectWrapper<RecipeCatalog>::kInternalFieldCount
+    );
+
+    // Methods
+    instanceTemplate->Set(
+        v8::String::NewFromUtf8(isolate, "load").ToLocalChecked(),
+        v8::FunctionTemplate::New(
+            isolate,
+            [](const v8::FunctionCallbackInfo<v8::Value> &args) {
+              auto *isolate = args.GetIsolate();
+              const auto catalog =
+                  V8ObjectWrapper<RecipeCatalog>::borrow(args.This());
+              if (!catalog || args.Length() < 1 || !args[0]->IsString()) {
+                return;
+              }
+
+              if (const auto records = loadInto(isolate, *catalog, args[0])) {
+                args.GetReturnValue().Set(static_cast<double>(*records));
+              }
+            }
+        )
+    );
+
+    instanceTemplate->Set(
+        v8::String::NewFromUtf8(isolate, "byName").ToLocalChecked(),
+        v8::FunctionTemplate::New(isolate, byNameCallback)
+    );
+
+    instanceTemplate->Set(
+        v8::String::NewFromUtf8(isolate, "query").ToLocalChecked(),
+        v8::FunctionTemplate::New(isolate, queryCallback)
+    );
+
+    instanceTemplate->Set(
+        v8::String::NewFromUtf8(isolate, "size").ToLocalChecked(),
+        v8::FunctionTemplate::New(
+            isolate,
+            [](const v8::FunctionCallbackInfo<v8::Value> &args) {
+              if (const auto catalog =
+                      V8ObjectWrapper<RecipeCatalog>::borrow(args.This())) {
+                args.GetReturnValue().Set(
+                    static_cast<double>(catalog->size())
+                );
+              }
+            }
+        )
+    );
+
+    return catalogTemplate;
+  }
+
+ private:
+  // Loads the file named by `path` and returns the number of records read,
+  // or throws a JS error and returns nothing
+  static std::optional<std::size_t> loadInto(
+      v8::Isolate *isolate, RecipeCatalog &catalog,
+      const v8::Local<v8::Value> path
+  ) {
+    const v8::String::Utf8Value str(isolate, path);
+    try {
+      return catalog.loadFile(*str);
+    } catch (const std::exception &e) {
+      isolate->ThrowException(v8::Exception::Error(
+          v8::String::NewFromUtf8(isolate, e.what()).ToLocalChecked()
+      ));
+      return std::nullopt;
+    }
+  }
+
+  static void byNameCallback(const v8::FunctionCallbackInfo<v8::Value> &args) {
+    auto *isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+
+    const auto catalog = V8ObjectWrapper<RecipeCatalog>::borrow(args.This());
+    if (!catalog || args.Length() < 1 || !args[0]->IsString()) {
+      args.GetReturnValue().SetNull();
+      return;
+    }
+
+    const v8::String::Utf8Value name(isolate, args[0]);
+    const auto recipe = catalog->byName(std::string_view(*name, name.length()));
+    if (!recipe) {
+      args.GetReturnValue().SetNull();
+      return;
+    }
+
+    args.GetReturnValue().Set(
+        RecipeBinding::Wrap(isolate, isolate->GetCurrentContext(), recipe)
+    );
+  }
+
+  // query(minStrength, maxStrength, minBrewTime?, maxBrewTime?)
+  static void queryCallback(const v8::FunctionCallbackInfo<v8::Value> &args) {
+    auto *isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+    const auto context = isolate->GetCurrentContext();
+
+    const auto catalog = V8ObjectWrapper<RecipeCatalog>::borrow(args.This());
+    if (!catalog) {
+      args.GetReturnValue().SetUndefined();
+      return;
+    }
+
+    int bounds[] = {0, RecipeCatalog::kMaxStrength, 0, INT_MAX};
+    for (int i = 0; i < 4; ++i) {
+      if (args.Length() > i && args[i]->IsNumber()) {
+        bounds[i] = args[i]->Int32Value(context).FromJust();
+      }
+    }
+
+    const auto recipes =
+        catalog->query(bounds[0], bounds[1], bounds[2], bounds[3]);
+
+    std::vector<v8::Local<v8::Value>> elements;
+    elements.reserve(recipes.size());
+    for (const auto &recipe : recipes) {
+      elements.push_back(RecipeBinding::Wrap(isolate, context, recipe));
+    }
+
+    args.GetReturnValue().Set(
+        v8::Array::New(isolate, elements.data(), elements.size())
+    );
+  }
+};
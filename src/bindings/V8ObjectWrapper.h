@@ -10,17 +10,24 @@
 // when objects are destroyed, and multiple JavaScript references may exist to
 // the same C++ object. shared_ptr ensures the object stays alive as long as
 // any V8 wrapper exists.
+//
+// Wrapped objects carry two internal fields: a per-class type tag and the
+// wrapper itself. Unwrapping compares the tag first, so handing a
+// CoffeeMachine to a method expecting a Recipe yields nullptr instead of a
+// bad cast. Objects not created from an API template are rejected before
+// any field is read.
 template <typename T>
 class V8ObjectWrapper {
  public:
+  // Instance templates of wrapped classes must reserve this many fields
+  static constexpr int kInternalFieldCount = 2;
+
   static void wrap(
       v8::Local<v8::Object> jsObject, std::shared_ptr<T> cppObject
   ) {
     auto *wrapper = new V8ObjectWrapper<T>(std::move(cppObject));
-    jsObject->SetInternalField(
-        0,
-        v8::External::New(jsObject->GetIsolate(), wrapper)
-    );
+    jsObject->SetAlignedPointerInInternalField(kTypeTagField, &typeTag_);
+    jsObject->SetAlignedPointerInInternalField(kWrapperField, wrapper);
 
     // Set up weak callback for cleanup when V8 garbage collects the object
     auto *isolate = jsObject->GetIsolate();
@@ -36,18 +43,45 @@ class V8ObjectWrapper {
     persistent.release();  // V8 now owns this
   }
 
+  // Borrowed pointer for the duration of a call. `jsObject` keeps the
+  // native object alive while the handle is in scope, so no reference count
+  // is touched. Returns nullptr if `jsObject` does not wrap a T.
+  static T *borrow(const v8::Local<v8::Object> jsObject) {
+    const auto *wrapper = find(jsObject);
+    return wrapper ? wrapper->object_.get() : nullptr;
+  }
+
+  // Shared ownership, for callers that must keep the object alive beyond
+  // the current call, e.g. queued async work. Prefer borrow() otherwise.
   static std::shared_ptr<T> unwrap(const v8::Local<v8::Object> jsObject) {
-    if (jsObject->InternalFieldCount() == 0) {
+    const auto *wrapper = find(jsObject);
+    return wrapper ? wrapper->object_ : nullptr;
+  }
+
+ private:
+  static constexpr int kTypeTagField = 0;
+  static constexpr int kWrapperField = 1;
+
+  // Only the address matters: one distinct, aligned tag per wrapped class.
+  // Deliberately non-const so the linker can never fold two tags together.
+  static inline int typeTag_ = 0;
+
+  // Builtins such as ArrayBuffer and typed arrays also have two internal
+  // fields that were never set as aligned pointers, so only objects made
+  // from an API template may have their fields read at all
+  static const V8ObjectWrapper<T> *find(const v8::Local<v8::Object> jsObject) {
+    if (!jsObject->IsApiWrapper() ||
+        jsObject->InternalFieldCount() != kInternalFieldCount ||
+        jsObject->GetAlignedPointerFromInternalField(kTypeTagField) !=
+            &typeTag_) {
       return nullptr;
     }
 
-    auto *wrapper = static_cast<V8ObjectWrapper<T> *>(
-        jsObject->GetInternalField(0).As<v8::External>()->Value()
+    return static_cast<V8ObjectWrapper<T> *>(
+        jsObject->GetAlignedPointerFromInternalField(kWrapperField)
     );
-    return wrapper ? wrapper->object_ : nullptr;
   }
 
- private:
   explicit V8ObjectWrapper(std::shared_ptr<T> object)
       : object_(std::move(object)) {}
 
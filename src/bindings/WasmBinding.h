@@ -0,0 +1,218 @@
+#pragma once
+
+#include <v8.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../WasmModuleCache.h"
+#include "../utils/MappedFile.h"
+#include "IsolateData.h"
+
+// loadWasm(path) and the streaming compilation behind it.
+//
+// A module already compiled in this process is re-created from the shared
+// compiled code. Otherwise the file goes through
+// WebAssembly.compileStreaming, with StreamingCallback feeding the mapped
+// file to V8 in chunks and offering any serialized module cached on disk.
+class WasmBinding {
+ public:
+  static v8::Local<v8::Function> CreateLoadWasm(
+      v8::Isolate * /*isolate*/, const v8::Local<v8::Context> context
+  ) {
+    return v8::Function::New(context, loadWasmCallback).ToLocalChecked();
+  }
+
+  // Installed with Isolate::SetWasmStreamingCallback. Receives the argument
+  // given to WebAssembly.compileStreaming, which here is a file path.
+  static void StreamingCallback(const v8::FunctionCallbackInfo<v8::Value> &args
+  ) {
+    auto *isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+    const auto streaming = v8::WasmStreaming::Unpack(isolate, args.Data());
+
+    if (args.Length() < 1 || !args[0]->IsString()) {
+      streaming->Abort(v8::Exception::TypeError(
+          v8::String::NewFromUtf8(
+              isolate,
+              "WebAssembly.compileStreaming expects a file path"
+          )
+              .ToLocalChecked()
+      ));
+      return;
+    }
+
+    const v8::String::Utf8Value path(isolate, args[0]);
+    std::shared_ptr<const MappedFile> file;
+    try {
+      file = MappedFile::open(*path);
+    } catch (const std::exception &e) {
+      streaming->Abort(v8::Exception::Error(
+          v8::String::NewFromUtf8(isolate, e.what()).ToLocalChecked()
+      ));
+      return;
+    }
+
+    auto &cache = IsolateData::Get(isolate)->wasmCache();
+    const auto key = WasmModuleCache::keyFor(file->view());
+
+    streaming->SetUrl(*path, path.length());
+
+    // Must stay alive until Finish() returns
+    const auto serialized = cache.readSerialized(key);
+    if (serialized) {
+      streaming->SetCompiledModuleBytes(serialized->data(), serialized->size());
+    }
+
+    // Refresh the disk entry as V8 tiers up more functions
+    streaming->SetMoreFunctionsCanBeSerializedCallback(
+        [&cache, key](v8::CompiledWasmModule module) {
+          cache.writeSerialized(key, std::move(module));
+        }
+    );
+
+    constexpr std::size_t kChunkSize = 64 * 1024;
+    const auto *bytes = reinterpret_cast<const uint8_t *>(file->data());
+    for (std::size_t offset = 0; offset < file->size(); offset += kChunkSize) {
+      streaming->OnBytesReceived(
+          bytes + offset,
+          std::min(kChunkSize, file->size() - offset)
+      );
+    }
+    streaming->Finish();
+  }
+
+ private:
+  static void loadWasmCallback(const v8::FunctionCallbackInfo<v8::Value> &args
+  ) {
+    auto *isolate = args.GetIsolate();
+    v8::HandleScope scope(isolate);
+    const auto context = isolate->GetCurrentContext();
+
+    if (args.Length() < 1 || !args[0]->IsString()) {
+      args.GetReturnValue().Set(
+          rejected(isolate, context, "loadWasm expects a file path")
+      );
+      return;
+    }
+
+    const v8::String::Utf8Value path(isolate, args[0]);
+    std::string key;
+    try {
+      const auto file = MappedFile::open(*path);
+      key = WasmModuleCache::keyFor(file->view());
+
+      auto &cache = IsolateData::Get(isolate)->wasmCache();
+      if (const auto compiled = cache.find(key, file->view())) {
+        const auto resolver =
+            v8::Promise::Resolver::New(context).ToLocalChecked();
+        resolver
+            ->Resolve(
+                context,
+                v8::WasmModuleObject::FromCompiledModule(isolate, *compiled)
+                    .ToLocalChecked()
+            )
+            .Check();
+        args.GetReturnValue().Set(resolver->GetPromise());
+        return;
+      }
+    } catch (const std::exception &e) {
+      args.GetReturnValue().Set(rejected(isolate, context, e.what()));
+      return;
+    }
+
+    // Not compiled in this process yet
+    v8::Local<v8::Value> webAssembly;
+    v8::Local<v8::Value> compileStreaming;
+    if (!getProperty(isolate, context, context->Global(), "WebAssembly")
+             .ToLocal(&webAssembly) ||
+        !webAssembly->IsObject() ||
+        !getProperty(
+             isolate,
+             context,
+             webAssembly.As<v8::Object>(),
+             "compileStreaming"
+        )
+             .ToLocal(&compileStreaming) ||
+        !compileStreaming->IsFunction()) {
+      args.GetReturnValue().Set(
+          rejected(isolate, context, "WebAssembly is not available")
+      );
+      return;
+    }
+
+    v8::Local<v8::Value> compileArgs[] = {args[0]};
+    v8::Local<v8::Value> compiling;
+    if (!compileStreaming.As<v8::Function>()
+             ->Call(context, webAssembly, 1, compileArgs)
+             .ToLocal(&compiling)) {
+      return;  // Exception already pending
+    }
+
+    // Hand the result to the shared cache, then to the script. The load
+    // counts as pending until either callback runs.
+    const auto remember =
+        v8::Function::New(
+            context,
+            rememberCallback,
+            v8::String::NewFromUtf8(isolate, key.c_str()).ToLocalChecked()
+        )
+            .ToLocalChecked();
+    const auto failed =
+        v8::Function::New(context, failedCallback).ToLocalChecked();
+    IsolateData::Get(isolate)->beginWasmLoad();
+    args.GetReturnValue().Set(
+        compiling.As<v8::Promise>()
+            ->Then(context, remember, failed)
+            .ToLocalChecked()
+    );
+  }
+
+  static void rememberCallback(const v8::FunctionCallbackInfo<v8::Value> &args
+  ) {
+    auto *isolate = args.GetIsolate();
+    IsolateData::Get(isolate)->endWasmLoad();
+
+    if (args.Length() > 0 && args[0]->IsWasmModuleObject()) {
+      const v8::String::Utf8Value key(isolate, args.Data());
+      IsolateData::Get(isolate)->wasmCache().remember(
+          *key,
+          args[0].As<v8::WasmModuleObject>()->GetCompiledModule()
+      );
+    }
+    args.GetReturnValue().Set(args[0]);
+  }
+
+  // Passes the rejection on to the script
+  static void failedCallback(const v8::FunctionCallbackInfo<v8::Value> &args
+  ) {
+    auto *isolate = args.GetIsolate();
+    IsolateData::Get(isolate)->endWasmLoad();
+    isolate->ThrowException(args[0]);
+  }
+
+  static v8::MaybeLocal<v8::Value> getProperty(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context,
+      const v8::Local<v8::Object> object, const char *name
+  ) {
+    return object->Get(
+        context,
+        v8::String::NewFromUtf8(isolate, name).ToLocalChecked()
+    );
+  }
+
+  static v8::Local<v8::Promise> rejected(
+      v8::Isolate *isolate, const v8::Local<v8::Context> context,
+      const char *message
+  ) {
+    const auto resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+    resolver
+        ->Reject(
+            context,
+            v8::String::NewFromUtf8(isolate, message).ToLocalChecked()
+        )
+        .Check();
+    return resolver->GetPromise();
+  }
+};
@@ -1,25 +1,17 @@
+#include "ScriptSource.h"
 #include "V8Platform.h"
 #include "V8Runtime.h"
 
+#include <charconv>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include <v8.h>
 
-std::string readFile(const std::string& filepath) {
-  std::ifstream file(filepath);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open file: " + filepath);
-  }
-
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  return buffer.str();
-}
-
 void generateTypeDefinitions(std::string_view outputPath) {
   std::ofstream file(outputPath.data());
   file << R"(// Auto-generated TypeScript definitions for V8 bindings
@@ -31,6 +23,31 @@ void generateTypeDefinitions(std::string_view outputPath) {
  */
 declare function wait(milliseconds: number): Promise<void>;
 
+/**
+ * Loads and compiles a WebAssembly module from a local file.
+ * Compilation streams from disk; compiled modules are cached on disk and
+ * shared across runtimes in the process, so later loads skip compilation.
+ * @param path The .wasm file to load
+ * @returns A promise that resolves with the compiled module
+ */
+declare function loadWasm(path: string): Promise<WebAssembly.Module>;
+
+/**
+ * Minimal WebAssembly declarations (not part of the ES2020 lib).
+ */
+declare namespace WebAssembly {
+    class Module {
+        constructor(bytes: ArrayBuffer | ArrayBufferView);
+    }
+
+    class Instance {
+        constructor(module: Module, imports?: Record<string, Record<string, unknown>>);
+        readonly exports: Record<string, any>;
+    }
+
+    function instantiate(module: Module, imports?: Record<string, Record<string, unknown>>): Promise<Instance>;
+}
+
 /**
  * Represents a coffee machine that can brew recipes.
  */
@@ -103,6 +120,64 @@ declare class Recipe {
     getDescription(): string;
 }
 
+/**
+ * A native, indexed collection of recipes loaded in bulk from disk.
+ * Identical recipes share a single Recipe instance.
+ */
+declare class RecipeCatalog {
+    /**
+     * Creates a catalog, optionally loading a file right away.
+     * @param path A .json file (array of recipe objects) or a CSV file
+     */
+    constructor(path?: string);
+
+    /**
+     * Loads recipes from a .json file (array of {name, strength, waterAmount, brewTime})
+     * or a CSV file with those columns.
+     * @param path The file to load
+     * @returns The number of records read, including duplicates
+     */
+    load(path: string): number;
+
+    /**
+     * Looks up a recipe by name.
+     * @param name The recipe name
+     * @returns The first recipe loaded under that name, or null
+     */
+    byName(name: string): Recipe | null;
+
+    /**
+     * Finds recipes within inclusive strength and brew time ranges.
+     * @param minStrength Minimum strength (0-100)
+     * @param maxStrength Maximum strength (0-100)
+     * @param minBrewTime Minimum brewing time in milliseconds
+     * @param maxBrewTime Maximum brewing time in milliseconds
+     * @returns Matching recipes ordered by strength, then brew time
+     */
+    query(minStrength: number, maxStrength: number, minBrewTime?: number, maxBrewTime?: number): Recipe[];
+
+    /**
+     * Gets the number of distinct recipes.
+     * @returns The catalog size
+     */
+    size(): number;
+}
+
+/**
+ * Events posted by the host application.
+ */
+declare const host: {
+    /**
+     * Subscribes to events of one type. The handler runs once per batch
+     * with every payload posted since the last delivery, oldest first:
+     * numbers, strings, ArrayBuffers (handed over without copying) or
+     * deserialized structured values.
+     * @param type The event type
+     * @param handler Receives the batch of payloads
+     */
+    on(type: string, handler: (payloads: unknown[]) => void): void;
+};
+
 /**
  * Console object for logging.
  */
@@ -117,22 +192,77 @@ declare const console: {
   file.close();
 }
 
-int main() {
+// Value of a `--name=value` option, if `arg` is that option
+std::optional<std::string_view> optionValue(
+    std::string_view arg, std::string_view prefix
+) {
+  if (!arg.starts_with(prefix)) {
+    return std::nullopt;
+  }
+  return arg.substr(prefix.size());
+}
+
+// A whole, non-negative decimal number
+std::optional<int> parseCount(std::string_view text) {
+  int value = 0;
+  const auto [end, error] =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc() || end != text.data() + text.size() || value < 0) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+int main(int argc, char* argv[]) {
+  // Parse command line options
+  V8RuntimeOptions options;
+  int workerThreads = 0;
+  std::string streamPath;
+  std::filesystem::path wasmCacheDirectory =
+      WasmModuleCache::defaultDirectory();
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--virtual-time") {
+      options.virtualTime = true;
+    } else if (const auto count = optionValue(arg, "--worker-threads=")) {
+      const auto parsed = parseCount(*count);
+      if (!parsed) {
+        std::cerr << "Invalid --worker-threads value: " << *count
+                  << " (expected a number >= 0)" << std::endl;
+        return 1;
+      }
+      workerThreads = *parsed;
+    } else if (const auto directory = optionValue(arg, "--wasm-cache=")) {
+      wasmCacheDirectory = *directory;
+    } else if (arg == "--stream") {
+      streamPath = "../scripts/index.js";
+    } else if (const auto path = optionValue(arg, "--stream=")) {
+      streamPath = *path;
+    }
+  }
+
   // Generate TypeScript definitions
   generateTypeDefinitions("../scripts/types.d.ts");
 
   // Initialize V8 platform (RAII handles cleanup)
-  V8Platform platform;
+  V8Platform platform(workerThreads, wasmCacheDirectory);
 
   // Create and initialize V8 runtime
-  V8Runtime runtime;
+  V8Runtime runtime(platform, options);
   runtime.initialize();
 
   // Load and execute script when ready
   try {
-    std::cout << "Loading JavaScript from ../scripts/index.js..." << std::endl;
-    const std::string jsCode = readFile("../scripts/index.js");
-    runtime.executeScript(jsCode);
+    if (!streamPath.empty()) {
+      std::cout << "Streaming JavaScript from " << streamPath << "..."
+                << std::endl;
+      runtime.executeStreamedScript(streamPath);
+    } else {
+      std::cout << "Loading JavaScript from ../scripts/index.js..."
+                << std::endl;
+      const auto script = ScriptSource::load("../scripts/index.js");
+      runtime.executeScript(*script);
+    }
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << std::endl;
     std::cerr << "\nMake sure to compile TypeScript first:" << std::endl;
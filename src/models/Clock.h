@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Source of time for everything that waits or reads time: brewing, wait()
+// and Date.
+//
+// RealClock follows the wall clock and really sleeps. VirtualClock starts at
+// a fixed instant and jumps forward on every sleep, so a day of simulated
+// brewing runs in milliseconds and replays identically. All sleeps happen
+// in call order on the isolate thread, so simulated time only ever moves
+// forward through them in timestamp order.
+class Clock {
+ public:
+  virtual ~Clock() = default;
+
+  // Milliseconds since the Unix epoch
+  virtual double now() const = 0;
+
+  virtual void sleepFor(std::chrono::milliseconds duration) = 0;
+
+  virtual bool isVirtual() const noexcept = 0;
+};
+
+class RealClock : public Clock {
+ public:
+  double now() const override {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::system_clock::now().time_since_epoch()
+    )
+        .count();
+  }
+
+  void sleepFor(std::chrono::milliseconds duration) override {
+    std::this_thread::sleep_for(duration);
+  }
+
+  bool isVirtual() const noexcept override { return false; }
+};
+
+class VirtualClock : public Clock {
+ public:
+  explicit VirtualClock(int64_t startMilliseconds = 0)
+      : now_(startMilliseconds) {}
+
+  double now() const override { return static_cast<double>(now_.load()); }
+
+  void sleepFor(std::chrono::milliseconds duration) override {
+    if (duration.count() > 0) {
+      now_ += duration.count();
+    }
+  }
+
+  bool isVirtual() const noexcept override { return true; }
+
+ private:
+  std::atomic<int64_t> now_;
+};
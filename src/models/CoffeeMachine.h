@@ -5,14 +5,20 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <thread>
 
+#include "Clock.h"
 #include "Recipe.h"
 
 class CoffeeMachine {
  public:
-  explicit CoffeeMachine(std::string_view name)
-      : name_(name), isOn_(false), isBrewing_(false) {}
+  explicit CoffeeMachine(
+      std::string_view name,
+      std::shared_ptr<Clock> clock = std::make_shared<RealClock>()
+  )
+      : name_(name),
+        clock_(std::move(clock)),
+        isOn_(false),
+        isBrewing_(false) {}
 
   void turnOn() noexcept { isOn_ = true; }
 
@@ -23,7 +29,7 @@ class CoffeeMachine {
 
   bool canBrew() const noexcept { return isOn_ && !isBrewing_; }
 
-  std::string brew(const std::shared_ptr<Recipe>& recipe) {
+  std::string brew(const Recipe* recipe) {
     if (!recipe) {
       throw std::invalid_argument("No recipe provided");
     }
@@ -36,9 +42,7 @@ class CoffeeMachine {
     isBrewing_ = true;
 
     // Simulate brewing delay
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(recipe->getBrewTime())
-    );
+    clock_->sleepFor(std::chrono::milliseconds(recipe->getBrewTime()));
 
     // Stop brewing
     isBrewing_ = false;
@@ -51,6 +55,7 @@ class CoffeeMachine {
 
  private:
   std::string name_;
+  std::shared_ptr<Clock> clock_;
   bool isOn_;
   bool isBrewing_;
 };
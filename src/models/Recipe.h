@@ -16,6 +16,8 @@ class Recipe {
 
   int getStrength() const noexcept { return strength_; }
 
+  int getWaterAmount() const noexcept { return waterAmount_; }
+
   int getBrewTime() const noexcept { return brewTime_; }
 
   std::string getDescription() const {
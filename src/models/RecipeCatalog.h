@@ -0,0 +1,681 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../utils/MappedFile.h"
+#include "Recipe.h"
+
+// In-memory menu of recipes with bulk loading and indexed lookups.
+//
+// Files are memory mapped and split at record boundaries so each worker
+// thread parses its own slice, using at most `maxThreads` threads per load.
+// Identical recipes are interned: the catalog keeps one shared Recipe per
+// distinct (name, strength, water, brew time), compared after Recipe's own
+// clamping.
+// Lookups by name are hashed; range queries walk one brew-time-sorted
+// bucket per strength value, which is cheap because strength is 0-100.
+class RecipeCatalog {
+ public:
+  static constexpr int kMaxStrength = 100;
+
+  // `maxThreads` bounds the threads one load may parse with, the calling
+  // thread included; 0 means one per hardware thread
+  explicit RecipeCatalog(std::size_t maxThreads = 0)
+      : maxThreads_(maxThreads) {}
+
+  // Loads a `.json` file holding an array of
+  // {"name", "strength", "waterAmount", "brewTime"} objects, or a CSV file
+  // with those columns in that order and an optional header row.
+  // Returns the number of records read, including duplicates.
+  std::size_t loadFile(const std::string &path) {
+    const auto file = MappedFile::open(path);
+    return path.ends_with(".json") ? loadJson(file->view())
+                                   : loadCsv(file->view());
+  }
+
+  std::size_t loadCsv(std::string_view text) {
+    return add(parseCsv(text, maxThreads_));
+  }
+
+  std::size_t loadJson(std::string_view text) {
+    return add(parseJson(text, maxThreads_));
+  }
+
+  // First recipe loaded under `name`, or nullptr
+  std::shared_ptr<Recipe> byName(std::string_view name) const {
+    const auto it = byName_.find(name);
+    return it != byName_.end() ? it->second : nullptr;
+  }
+
+  // Recipes with strength and brew time inside the given inclusive ranges,
+  // ordered by strength, then brew time
+  std::vector<std::shared_ptr<Recipe>> query(
+      int minStrength, int maxStrength, int minBrewTime, int maxBrewTime
+  ) const {
+    std::vector<std::shared_ptr<Recipe>> result;
+    if (minBrewTime > maxBrewTime) {
+      return result;
+    }
+
+    const auto brewTime = [](const std::shared_ptr<Recipe> &recipe) {
+      return recipe->getBrewTime();
+    };
+
+    for (int strength = std::max(minStrength, 0);
+         strength <= std::min(maxStrength, kMaxStrength);
+         ++strength) {
+      const auto &bucket = byStrength_[strength];
+      const auto first =
+          std::ranges::lower_bound(bucket, minBrewTime, {}, brewTime);
+      const auto last = std::ranges::upper_bound(
+          first, bucket.end(), maxBrewTime, {}, brewTime
+      );
+      result.insert(result.end(), first, last);
+    }
+    return result;
+  }
+
+  // Number of distinct recipes
+  std::size_t size() const noexcept { return interned_.size(); }
+
+ private:
+  struct Record {
+    std::string name;
+    int strength = 0;
+    int waterAmount = 0;
+    int brewTime = 0;
+  };
+
+  using Batch = std::vector<Record>;
+
+  // Interning compares recipes by value, after Recipe has normalized the
+  // fields. Transparent so a stack candidate can be looked up directly.
+  struct RecipeHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const Recipe &recipe) const noexcept {
+      std::size_t hash = std::hash<std::string>{}(recipe.getName());
+      for (const int value :
+           {recipe.getStrength(),
+            recipe.getWaterAmount(),
+            recipe.getBrewTime()}) {
+        hash ^= std::hash<int>{}(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+                (hash >> 2);
+      }
+      return hash;
+    }
+
+    std::size_t operator()(const std::shared_ptr<Recipe> &recipe
+    ) const noexcept {
+      return (*this)(*recipe);
+    }
+  };
+
+  struct RecipeEqual {
+    using is_transparent = void;
+
+    static const Recipe &deref(const Recipe &recipe) { return recipe; }
+
+    static const Recipe &deref(const std::shared_ptr<Recipe> &recipe) {
+      return *recipe;
+    }
+
+    template <typename A, typename B>
+    bool operator()(const A &lhs, const B &rhs) const noexcept {
+      const Recipe &a = deref(lhs);
+      const Recipe &b = deref(rhs);
+      return a.getStrength() == b.getStrength() &&
+             a.getWaterAmount() == b.getWaterAmount() &&
+             a.getBrewTime() == b.getBrewTime() && a.getName() == b.getName();
+    }
+  };
+
+  // Merges parsed batches in file order, so "first under a name" is
+  // deterministic regardless of how the file was split
+  std::size_t add(std::vector<Batch> batches) {
+    std::size_t records = 0;
+    for (const auto &batch : batches) {
+      records += batch.size();
+    }
+    interned_.reserve(interned_.size() + records);
+    byName_.reserve(byName_.size() + records);
+
+    std::array<std::size_t, kMaxStrength + 1> sortedUpTo{};
+    for (int strength = 0; strength <= kMaxStrength; ++strength) {
+      sortedUpTo[strength] = byStrength_[strength].size();
+    }
+
+    for (auto &batch : batches) {
+      for (auto &record : batch) {
+        Recipe candidate(
+            record.name,
+            record.strength,
+            record.waterAmount,
+            record.brewTime
+        );
+        if (interned_.find(candidate) != interned_.end()) {
+          continue;
+        }
+
+        auto recipe = std::make_shared<Recipe>(std::move(candidate));
+        interned_.insert(recipe);
+        byName_.try_emplace(recipe->getName(), recipe);
+        byStrength_[recipe->getStrength()].push_back(std::move(recipe));
+      }
+    }
+
+    // Sort only what was appended, then merge with the existing sorted run
+    const auto byBrewTime = [](const std::shared_ptr<Recipe> &a,
+                               const std::shared_ptr<Recipe> &b) {
+      return a->getBrewTime() < b->getBrewTime();
+    };
+    for (int strength = 0; strength <= kMaxStrength; ++strength) {
+      auto &bucket = byStrength_[strength];
+      const auto middle = bucket.begin() + sortedUpTo[strength];
+      if (middle == bucket.end()) {
+        continue;
+      }
+      std::stable_sort(middle, bucket.end(), byBrewTime);
+      std::inplace_merge(bucket.begin(), middle, bucket.end(), byBrewTime);
+    }
+
+    return records;
+  }
+
+  // Parses each piece on its own thread; the calling thread takes the first.
+  // `parse` receives the piece and its index.
+  template <typename Parse>
+  static std::vector<Batch> parallelParse(
+      const std::vector<std::string_view> &pieces, Parse parse
+  ) {
+    std::vector<Batch> batches(pieces.size());
+    std::vector<std::exception_ptr> errors(pieces.size());
+
+    const auto run = [&](std::size_t i) {
+      try {
+        batches[i] = parse(pieces[i], i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(pieces.size());
+    for (std::size_t i = 1; i < pieces.size(); ++i) {
+      workers.emplace_back(run, i);
+    }
+    if (!pieces.empty()) {
+      run(0);
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+
+    for (const auto &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+    return batches;
+  }
+
+  // Small inputs are not worth a thread
+  static std::size_t workerCount(std::size_t bytes, std::size_t maxThreads) {
+    constexpr std::size_t kMinBytesPerWorker = 256 * 1024;
+    const std::size_t limit =
+        maxThreads > 0 ? maxThreads
+                       : std::max(1u, std::thread::hardware_concurrency());
+    return std::clamp<std::size_t>(bytes / kMinBytesPerWorker, 1, limit);
+  }
+
+  [[noreturn]] static void malformed(std::string_view what) {
+    throw std::runtime_error("Malformed recipe data: " + std::string(what));
+  }
+
+  static std::string_view trim(std::string_view text) {
+    const auto first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+      return {};
+    }
+    const auto last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+  }
+
+  static std::string_view skipByteOrderMark(std::string_view text) {
+    if (text.starts_with("\xEF\xBB\xBF")) {
+      text.remove_prefix(3);
+    }
+    return text;
+  }
+
+  static int parseInt(std::string_view text, std::string_view context) {
+    text = trim(text);
+    int value = 0;
+    const auto [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size()) {
+      malformed(context);
+    }
+    return value;
+  }
+
+  // CSV
+
+  static std::vector<Batch> parseCsv(
+      std::string_view text, std::size_t maxThreads
+  ) {
+    text = skipByteOrderMark(text);
+
+    // Skip a header row
+    if (isCsvHeader(text.substr(0, text.find('\n')))) {
+      const auto end = text.find('\n');
+      text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+
+    // Cut into roughly equal slices, each ending on a line break
+    const std::size_t workers = workerCount(text.size(), maxThreads);
+    std::vector<std::string_view> pieces;
+    std::size_t start = 0;
+    for (std::size_t k = 1; k < workers; ++k) {
+      const auto cut = text.find(
+          '\n',
+          std::max(start, text.size() * k / workers)
+      );
+      if (cut == std::string_view::npos) {
+        break;
+      }
+      pieces.push_back(text.substr(start, cut + 1 - start));
+      start = cut + 1;
+    }
+    pieces.push_back(text.substr(start));
+
+    return parallelParse(pieces, parseCsvLines);
+  }
+
+  // Only the exact column names count as a header; a recipe whose name
+  // happens to start with "name" is data
+  static bool isCsvHeader(std::string_view line) {
+    constexpr std::string_view kColumns[] = {
+        "name",
+        "strength",
+        "waterAmount",
+        "brewTime"
+    };
+
+    for (std::size_t i = 0; i < std::size(kColumns); ++i) {
+      const auto comma = line.find(',');
+      const bool last = i + 1 == std::size(kColumns);
+      if (last != (comma == std::string_view::npos) ||
+          trim(line.substr(0, comma)) != kColumns[i]) {
+        return false;
+      }
+      line.remove_prefix(last ? line.size() : comma + 1);
+    }
+    return true;
+  }
+
+  static Batch parseCsvLines(std::string_view text, std::size_t /*slice*/) {
+    Batch batch;
+    batch.reserve(text.size() / 32);
+
+    while (!text.empty()) {
+      const auto end = text.find('\n');
+      const auto line = text.substr(0, end);
+      text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+      if (!trim(line).empty()) {
+        batch.push_back(parseCsvRecord(line));
+      }
+    }
+    return batch;
+  }
+
+  // name,strength,waterAmount,brewTime
+  // The name may be double-quoted, with "" for a literal quote. Quoted
+  // fields cannot span lines.
+  static Record parseCsvRecord(std::string_view line) {
+    Record record;
+    std::string_view rest = trim(line);
+
+    if (rest.starts_with('"')) {
+      std::size_t i = 1;
+      for (;; ++i) {
+        if (i >= rest.size()) {
+          malformed(line);
+        }
+        if (rest[i] == '"') {
+          if (i + 1 < rest.size() && rest[i + 1] == '"') {
+            record.name.push_back('"');
+            ++i;
+            continue;
+          }
+          break;
+        }
+        record.name.push_back(rest[i]);
+      }
+      rest.remove_prefix(i + 1);
+      rest = trim(rest);
+      if (!rest.starts_with(',')) {
+        malformed(line);
+      }
+      rest.remove_prefix(1);
+    } else {
+      const auto comma = rest.find(',');
+      if (comma == std::string_view::npos) {
+        malformed(line);
+      }
+      record.name = trim(rest.substr(0, comma));
+      rest.remove_prefix(comma + 1);
+    }
+
+    int *const fields[] = {
+        &record.strength,
+        &record.waterAmount,
+        &record.brewTime
+    };
+    for (std::size_t i = 0; i < std::size(fields); ++i) {
+      const auto comma = rest.find(',');
+      const bool last = i + 1 == std::size(fields);
+      if (last != (comma == std::string_view::npos)) {
+        malformed(line);
+      }
+      *fields[i] = parseInt(rest.substr(0, comma), line);
+      rest.remove_prefix(last ? rest.size() : comma + 1);
+    }
+
+    return record;
+  }
+
+  // JSON
+
+  static std::vector<Batch> parseJson(
+      std::string_view text, std::size_t maxThreads
+  ) {
+    text = trim(skipByteOrderMark(text));
+    if (!text.starts_with('[') || !text.ends_with(']')) {
+      malformed("expected a JSON array of recipe objects");
+    }
+    text = text.substr(1, text.size() - 2);
+
+    // A quick structural pass finds object boundaries near the ideal cut
+    // points; the full parse of each slice then runs in parallel
+    const std::size_t workers = workerCount(text.size(), maxThreads);
+    std::vector<std::string_view> pieces;
+    std::size_t start = 0;
+    std::size_t nextCut = text.size() / workers;
+    int depth = 0;
+    bool inString = false;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      const char c = text[i];
+      if (inString) {
+        if (c == '\\') {
+          ++i;
+        } else if (c == '"') {
+          inString = false;
+        }
+      } else if (c == '"') {
+        inString = true;
+      } else if (c == '{' || c == '[') {
+        ++depth;
+      } else if (c == '}' || c == ']') {
+        if (--depth < 0) {
+          malformed("unbalanced brackets");
+        }
+        if (depth == 0 && i >= nextCut && pieces.size() + 1 < workers) {
+          pieces.push_back(text.substr(start, i + 1 - start));
+          start = i + 1;
+          nextCut = text.size() * (pieces.size() + 1) / workers;
+        }
+      }
+    }
+    if (depth != 0 || inString) {
+      malformed("unterminated JSON");
+    }
+    // A cut after the last object leaves only whitespace behind
+    if (pieces.empty() || !trim(text.substr(start)).empty()) {
+      pieces.push_back(text.substr(start));
+    }
+
+    return parallelParse(pieces, parseJsonObjects);
+  }
+
+  // A comma-separated run of flat recipe objects. Slices are cut right after
+  // an object, so every slice but the first must start with the comma that
+  // separates it from the previous one.
+  static Batch parseJsonObjects(std::string_view text, std::size_t slice) {
+    Batch batch;
+    batch.reserve(text.size() / 64);
+
+    skipJsonWhitespace(text);
+    if (slice == 0 && text.starts_with(',')) {
+      malformed("unexpected ',' before the first recipe");
+    }
+    if (slice > 0) {
+      if (!text.starts_with(',')) {
+        malformed("expected ',' between recipes");
+      }
+      text.remove_prefix(1);
+      skipJsonWhitespace(text);
+      if (text.empty()) {
+        malformed("trailing ',' after the last recipe");
+      }
+    }
+    while (true) {
+      skipJsonWhitespace(text);
+      if (text.empty()) {
+        break;
+      }
+      batch.push_back(parseJsonObject(text));
+      skipJsonWhitespace(text);
+      if (text.starts_with(',')) {
+        text.remove_prefix(1);
+        skipJsonWhitespace(text);
+        if (text.empty()) {
+          malformed("trailing ',' after the last recipe");
+        }
+      } else if (!text.empty()) {
+        malformed("expected ',' between recipes");
+      }
+    }
+    return batch;
+  }
+
+  static Record parseJsonObject(std::string_view &text) {
+    enum : unsigned { kName = 1, kStrength = 2, kWater = 4, kBrewTime = 8 };
+
+    Record record;
+    unsigned seen = 0;
+
+    expectJson(text, '{');
+    skipJsonWhitespace(text);
+    if (text.starts_with('}')) {
+      malformed("empty recipe object");
+    }
+
+    while (true) {
+      skipJsonWhitespace(text);
+      const std::string key = parseJsonString(text);
+      skipJsonWhitespace(text);
+      expectJson(text, ':');
+      skipJsonWhitespace(text);
+
+      if (key == "name") {
+        record.name = parseJsonString(text);
+        seen |= kName;
+      } else if (key == "strength") {
+        record.strength = parseJsonInt(text);
+        seen |= kStrength;
+      } else if (key == "waterAmount") {
+        record.waterAmount = parseJsonInt(text);
+        seen |= kWater;
+      } else if (key == "brewTime") {
+        record.brewTime = parseJsonInt(text);
+        seen |= kBrewTime;
+      } else {
+        skipJsonScalar(text);
+      }
+
+      skipJsonWhitespace(text);
+      if (text.starts_with(',')) {
+        text.remove_prefix(1);
+        continue;
+      }
+      expectJson(text, '}');
+      break;
+    }
+
+    if (seen != (kName | kStrength | kWater | kBrewTime)) {
+      malformed("recipe object is missing a field: " + record.name);
+    }
+    return record;
+  }
+
+  static void skipJsonWhitespace(std::string_view &text) {
+    const auto first = text.find_first_not_of(" \t\r\n");
+    text.remove_prefix(first == std::string_view::npos ? text.size() : first);
+  }
+
+  static void expectJson(std::string_view &text, char expected) {
+    if (!text.starts_with(expected)) {
+      malformed(std::string("expected '") + expected + "'");
+    }
+    text.remove_prefix(1);
+  }
+
+  static int parseJsonInt(std::string_view &text) {
+    const auto end = text.find_first_of(",}] \t\r\n");
+    const auto number = text.substr(0, end);
+    text.remove_prefix(number.size());
+    return parseInt(number, number);
+  }
+
+  // Unknown fields are ignored as long as they hold plain values
+  static void skipJsonScalar(std::string_view &text) {
+    if (text.starts_with('"')) {
+      parseJsonString(text);
+      return;
+    }
+    if (text.starts_with('{') || text.starts_with('[')) {
+      malformed("nested values are not supported in recipe objects");
+    }
+    const auto end = text.find_first_of(",}");
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end);
+  }
+
+  static std::string parseJsonString(std::string_view &text) {
+    expectJson(text, '"');
+
+    std::string out;
+    while (true) {
+      const auto special = text.find_first_of("\"\\");
+      if (special == std::string_view::npos) {
+        malformed("unterminated string");
+      }
+      out.append(text.substr(0, special));
+      const char c = text[special];
+      text.remove_prefix(special + 1);
+      if (c == '"') {
+        return out;
+      }
+
+      if (text.empty()) {
+        malformed("unterminated string");
+      }
+      const char escape = text.front();
+      text.remove_prefix(1);
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          out.push_back(escape);
+          break;
+        case 'b':
+          out.push_back('\b');
+          break;
+        case 'f':
+          out.push_back('\f');
+          break;
+        case 'n':
+          out.push_back('\n');
+          break;
+        case 'r':
+          out.push_back('\r');
+          break;
+        case 't':
+          out.push_back('\t');
+          break;
+        case 'u':
+          appendUtf8(out, parseJsonCodePoint(text));
+          break;
+        default:
+          malformed("invalid escape in string");
+      }
+    }
+  }
+
+  // \uXXXX, combining a surrogate pair when one follows
+  static char32_t parseJsonCodePoint(std::string_view &text) {
+    const auto hex4 = [](std::string_view &in) {
+      unsigned value = 0;
+      if (in.size() < 4) {
+        malformed("truncated \\u escape");
+      }
+      const auto [end, error] =
+          std::from_chars(in.data(), in.data() + 4, value, 16);
+      if (error != std::errc() || end != in.data() + 4) {
+        malformed("invalid \\u escape");
+      }
+      in.remove_prefix(4);
+      return static_cast<char32_t>(value);
+    };
+
+    const char32_t high = hex4(text);
+    if (high >= 0xD800 && high <= 0xDBFF && text.starts_with("\\u")) {
+      std::string_view lookahead = text.substr(2);
+      const char32_t low = hex4(lookahead);
+      if (low >= 0xDC00 && low <= 0xDFFF) {
+        text = lookahead;
+        return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+      }
+    }
+    return (high >= 0xD800 && high <= 0xDFFF) ? 0xFFFD : high;
+  }
+
+  static void appendUtf8(std::string &out, char32_t codePoint) {
+    if (codePoint < 0x80) {
+      out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+  }
+
+  std::size_t maxThreads_;
+  std::unordered_set<std::shared_ptr<Recipe>, RecipeHash, RecipeEqual>
+      interned_;
+  std::unordered_map<std::string_view, std::shared_ptr<Recipe>> byName_;
+  std::array<std::vector<std::shared_ptr<Recipe>>, kMaxStrength + 1>
+      byStrength_;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+// Read-only memory mapping of a file.
+//
+// Mappings are cached by file identity and version (device, inode, size and
+// modification time): every caller in the process that opens the same,
+// unchanged file while a previous mapping is still alive gets that mapping
+// back, so several runtimes loading the same bundle share one set of pages.
+// Opening a file again after it was replaced creates a new mapping.
+//
+// An existing mapping is not protected from the file changing underneath
+// it: contents rewritten in place show through, and reading pages past a
+// truncation raises SIGBUS. Replace mapped files by renaming a new file over
+// them, never by rewriting them in place.
+class MappedFile {
+ public:
+  static std::shared_ptr<const MappedFile> open(const std::string &path) {
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<const MappedFile>> cache;
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to stat file: " + path);
+    }
+    const Key key = keyFor(info);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::erase_if(cache, [](const auto &entry) {
+      return entry.second.expired();
+    });
+
+    if (const auto it = cache.find(key); it != cache.end()) {
+      if (auto existing = it->second.lock()) {
+        ::close(fd);
+        return existing;
+      }
+    }
+
+    std::shared_ptr<const MappedFile> file(new MappedFile(path, fd, info));
+    cache[key] = file;
+    return file;
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile() {
+    if (data_) {
+      munmap(const_cast<char *>(data_), size_);
+    }
+  }
+
+  std::string_view view() const noexcept { return {data_, size_}; }
+
+  const char *data() const noexcept { return data_; }
+
+  std::size_t size() const noexcept { return size_; }
+
+  const std::string &path() const noexcept { return path_; }
+
+ private:
+  // Device, inode, size, modification time (seconds, nanoseconds)
+  using Key = std::tuple<dev_t, ino_t, off_t, int64_t, int64_t>;
+
+  static Key keyFor(const struct stat &info) noexcept {
+#ifdef __APPLE__
+    const auto &modified = info.st_mtimespec;
+#else
+    const auto &modified = info.st_mtim;
+#endif
+    return {
+        info.st_dev,
+        info.st_ino,
+        info.st_size,
+        static_cast<int64_t>(modified.tv_sec),
+        static_cast<int64_t>(modified.tv_nsec)
+    };
+  }
+
+  // Takes ownership of `fd`
+  MappedFile(std::string path, const int fd, const struct stat &info)
+      : path_(std::move(path)),
+        data_(nullptr),
+        size_(static_cast<std::size_t>(info.st_size)) {
+    // mmap rejects zero-length mappings; an empty file is just empty data
+    if (size_ > 0) {
+      void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Failed to map file: " + path_);
+      }
+      data_ = static_cast<const char *>(mapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+  }
+
+  std::string path_;
+  const char *data_;
+  std::size_t size_;
+};
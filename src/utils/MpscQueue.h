@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Lock-free multi-producer, single-consumer queue.
+//
+// Producers push onto an intrusive stack with a single CAS. The consumer
+// never pops one item at a time: drain() swaps the whole stack out with one
+// exchange and reverses it, so a burst of pushes costs the consumer one
+// atomic operation and comes back oldest first.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() = default;
+
+  ~MpscQueue() { drain(); }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  // Safe from any thread. Returns true if the queue was empty, so exactly
+  // one producer sees each transition to non-empty and can wake the
+  // consumer.
+  bool push(T value) {
+    auto *node =
+        new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+    bool wasEmpty;
+    do {
+      wasEmpty = node->next == nullptr;
+    } while (!head_.compare_exchange_weak(
+        node->next,
+        node,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ));
+    // Not node->next: once published, the consumer may already own `node`
+    return wasEmpty;
+  }
+
+  // Everything pushed so far, in push order. Consumer thread only.
+  std::vector<T> drain() {
+    Node *node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    std::size_t count = 0;
+    for (const Node *it = node; it; it = it->next) {
+      ++count;
+    }
+
+    // The stack is newest first; fill the batch from the back
+    std::vector<T> batch(count);
+    while (node) {
+      batch[--count] = std::move(node->value);
+      delete std::exchange(node, node->next);
+    }
+    return batch;
+  }
+
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_relaxed) == nullptr;
+  }
+
+ private:
+  struct Node {
+    T value;
+    Node *next;
+  };
+
+  std::atomic<Node *> head_{nullptr};
+};
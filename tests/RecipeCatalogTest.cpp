@@ -0,0 +1,200 @@
+// Parser tests for RecipeCatalog. Needs no V8; exits non-zero on failure.
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "../src/models/RecipeCatalog.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, std::string_view what) {
+  if (!condition) {
+    ++failures;
+    std::cerr << "FAILED: " << what << std::endl;
+  }
+}
+
+bool throws(const std::function<void()> &action) {
+  try {
+    action();
+  } catch (const std::exception &) {
+    return true;
+  }
+  return false;
+}
+
+std::string recipeJson(int i) {
+  return "{\"name\": \"Recipe " + std::to_string(i) +
+         "\", \"strength\": " + std::to_string(i % 101) +
+         ", \"waterAmount\": " + std::to_string(30 + i % 200) +
+         ", \"brewTime\": " + std::to_string(1000 + i) + "}";
+}
+
+std::string recipeCsv(int i) {
+  return "\"Recipe " + std::to_string(i) + "\"," + std::to_string(i % 101) +
+         "," + std::to_string(30 + i % 200) + "," +
+         std::to_string(1000 + i) + "\n";
+}
+
+// Large enough to be cut into several slices
+constexpr int kManyRecipes = 40000;
+
+std::string manyJson() {
+  std::string text = "[";
+  for (int i = 0; i < kManyRecipes; ++i) {
+    text += (i > 0 ? ",\n" : "") + recipeJson(i);
+  }
+  return text + "]";
+}
+
+std::string manyCsv() {
+  std::string text = "name,strength,waterAmount,brewTime\n";
+  for (int i = 0; i < kManyRecipes; ++i) {
+    text += recipeCsv(i);
+  }
+  return text;
+}
+
+void testCsvHeader() {
+  RecipeCatalog withHeader;
+  check(
+      withHeader.loadCsv(
+          " name , strength,waterAmount,brewTime\r\nMocha,60,100,2000\n"
+      ) == 1,
+      "CSV header row is skipped"
+  );
+
+  RecipeCatalog nameLike;
+  check(
+      nameLike.loadCsv("nameless blend,50,200,1000\nMocha,60,100,2000\n") == 2,
+      "a first record starting with \"name\" is data"
+  );
+  check(nameLike.byName("nameless blend") != nullptr, "name-like record kept");
+}
+
+void testCsvQuotedNames() {
+  RecipeCatalog catalog;
+  check(
+      catalog.loadCsv(
+          "\"Flat, White\",70,150,3000\n\"Say \"\"Hi\"\"\",40,90,1500\n"
+      ) == 2,
+      "quoted CSV names load"
+  );
+  check(catalog.byName("Flat, White") != nullptr, "comma inside quotes");
+  check(catalog.byName("Say \"Hi\"") != nullptr, "doubled quote unescaped");
+  check(
+      throws([] { RecipeCatalog().loadCsv("\"Unclosed,70,150,3000\n"); }),
+      "unterminated quote is rejected"
+  );
+}
+
+void testCsvCommas() {
+  check(
+      throws([] { RecipeCatalog().loadCsv("Mocha,60,100\n"); }),
+      "missing CSV field is rejected"
+  );
+  check(
+      throws([] { RecipeCatalog().loadCsv("Mocha,60,100,2000,\n"); }),
+      "trailing CSV comma is rejected"
+  );
+  check(
+      throws([] { RecipeCatalog().loadCsv("Mocha,60,,100,2000\n"); }),
+      "empty CSV field is rejected"
+  );
+}
+
+void testJsonCommas() {
+  const std::string one = recipeJson(1);
+  const std::string two = recipeJson(2);
+
+  check(RecipeCatalog().loadJson("[]") == 0, "empty array loads");
+  check(
+      RecipeCatalog().loadJson("[" + one + ", " + two + "]") == 2,
+      "comma-separated objects load"
+  );
+  check(
+      throws([&] { RecipeCatalog().loadJson("[," + one + "]"); }),
+      "leading comma is rejected"
+  );
+  check(
+      throws([&] { RecipeCatalog().loadJson("[" + one + ",]"); }),
+      "trailing comma is rejected"
+  );
+  check(
+      throws([&] { RecipeCatalog().loadJson("[" + one + two + "]"); }),
+      "missing comma is rejected"
+  );
+  check(
+      throws([&] { RecipeCatalog().loadJson("[" + one + ",," + two + "]"); }),
+      "doubled comma is rejected"
+  );
+}
+
+// Every slice count must give the same recipes and the same verdicts
+void testSliceIndependence() {
+  const std::string json = manyJson();
+  const std::string csv = manyCsv();
+
+  for (std::size_t threads = 1; threads <= 8; ++threads) {
+    const std::string label = " with " + std::to_string(threads) + " threads";
+
+    RecipeCatalog fromJson(threads);
+    check(fromJson.loadJson(json) == kManyRecipes, "JSON count" + label);
+    RecipeCatalog fromCsv(threads);
+    check(fromCsv.loadCsv(csv) == kManyRecipes, "CSV count" + label);
+
+    const auto fromJsonQuery = fromJson.query(0, 100, 0, 1 << 30);
+    const auto fromCsvQuery = fromCsv.query(0, 100, 0, 1 << 30);
+    bool same = fromJsonQuery.size() == fromCsvQuery.size();
+    for (std::size_t i = 0; same && i < fromJsonQuery.size(); ++i) {
+      same = fromJsonQuery[i]->getName() == fromCsvQuery[i]->getName() &&
+             fromJsonQuery[i]->getBrewTime() == fromCsvQuery[i]->getBrewTime();
+    }
+    check(same, "JSON and CSV agree" + label);
+
+    // Drop the separator next to each point where a cut lands, so the
+    // missing comma falls exactly between two slices
+    for (std::size_t k = 1; k < threads; ++k) {
+      const auto at = json.find("},", json.size() * k / threads);
+      for (const auto separator : {json.rfind("},", at - 1), at}) {
+        const std::string broken =
+            json.substr(0, separator + 1) + json.substr(separator + 2);
+        check(
+            throws([&] { RecipeCatalog(threads).loadJson(broken); }),
+            "missing comma at a slice boundary is rejected" + label
+        );
+      }
+    }
+    check(
+        throws([&] {
+          RecipeCatalog(threads).loadJson(
+              json.substr(0, json.size() - 1) + ",]"
+          );
+        }),
+        "trailing comma is rejected" + label
+    );
+  }
+}
+
+}  // namespace
+
+int main() {
+  testCsvHeader();
+  testCsvQuotedNames();
+  testCsvCommas();
+  testJsonCommas();
+  testSliceIndependence();
+
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All RecipeCatalog tests passed" << std::endl;
+  return 0;
+}